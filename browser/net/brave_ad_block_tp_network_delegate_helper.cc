@@ -10,6 +10,7 @@
 
 #include "base/base64url.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
@@ -18,6 +19,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_request.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/grit/brave_generated_resources.h"
@@ -94,28 +96,26 @@ void OnBeforeURLRequestAdBlockTPOnTaskRunner(
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
+  // The request is normalized once and shared by every enabled list.
+  brave_shields::ShieldsRequest request(ctx->request_url, ctx->resource_type,
+                                        ctx->tab_origin.host());
   bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
   if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly)) {
+          request, &did_match_exception, &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_regional_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->tracking_protection_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kTrackerBlocked;
   }
@@ -168,11 +168,16 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
-  g_brave_browser_process->ad_block_service()->
-        GetTaskRunner()->PostTaskAndReply(FROM_HERE,
-          base::Bind(&OnBeforeURLRequestAdBlockTPOnTaskRunner, ctx),
-          base::Bind(base::IgnoreResult(
-              &OnBeforeURLRequestDispatchOnIOThread), next_callback, ctx));
+  // Matching runs on the thread pool instead of the sequence that loads the
+  // lists. Each list keeps a small pool of matchers, so concurrent requests
+  // only wait for each other once they outnumber a list's matchers.
+  base::PostTaskWithTraitsAndReply(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::Bind(&OnBeforeURLRequestAdBlockTPOnTaskRunner, ctx),
+      base::Bind(base::IgnoreResult(
+          &OnBeforeURLRequestDispatchOnIOThread), next_callback, ctx));
 
   return net::ERR_IO_PENDING;
 }
@@ -8,9 +8,14 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/metrics/histogram.h"
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
@@ -35,6 +40,52 @@ using net::URLRequest;
 
 namespace {
 
+const size_t kMaxPooledRequestContexts = 64;
+
+// Helper latencies are recorded in microseconds, up to ten seconds.
+const int kMaxHelperTimeMicroseconds = 10 * 1000 * 1000;
+const int kHelperTimeBuckets = 50;
+
+const char* GetEventTypeName(brave::BraveNetworkDelegateEventType event_type) {
+  switch (event_type) {
+    case brave::kOnBeforeRequest:
+      return "OnBeforeURLRequest";
+    case brave::kOnBeforeStartTransaction:
+      return "OnBeforeStartTransaction";
+    case brave::kOnHeadersReceived:
+      return "OnHeadersReceived";
+    case brave::kOnCanGetCookies:
+      return "OnCanGetCookies";
+    case brave::kOnCanSetCookies:
+      return "OnCanSetCookies";
+    case brave::kUnknownEventType:
+      break;
+  }
+  return "Unknown";
+}
+
+// Returns Brave.NetworkDelegate.<event>.<helper>.<metric>. |helper| is empty
+// for metrics that cover the whole event. Histograms live for the rest of the
+// process, so the result can be kept and recorded into from the IO thread.
+base::HistogramBase* GetPipelineTimeHistogram(
+    brave::BraveNetworkDelegateEventType event_type,
+    const std::string& helper,
+    const char* metric) {
+  std::string name = helper.empty() ?
+      base::StringPrintf("Brave.NetworkDelegate.%s.%s",
+                         GetEventTypeName(event_type), metric) :
+      base::StringPrintf("Brave.NetworkDelegate.%s.%s.%s",
+                         GetEventTypeName(event_type), helper.c_str(), metric);
+  return base::Histogram::FactoryGet(
+      name, 1, kMaxHelperTimeMicroseconds, kHelperTimeBuckets,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+}
+
+void RecordPipelineTime(base::HistogramBase* histogram, base::TimeDelta time) {
+  histogram->Add(static_cast<base::HistogramBase::Sample>(std::min<int64_t>(
+      time.InMicroseconds(), kMaxHelperTimeMicroseconds)));
+}
+
 content::WebContents* GetWebContentsFromProcessAndFrameId(int render_process_id,
                                                           int render_frame_id) {
   if (render_process_id) {
@@ -99,8 +150,15 @@ void RemoveTrackableSecurityHeadersForThirdParty(
 
 BraveNetworkDelegateBase::BraveNetworkDelegateBase(
     extensions::EventRouterForwarder* event_router)
-    : ChromeNetworkDelegate(event_router), referral_headers_list_(nullptr),
+    : ChromeNetworkDelegate(event_router),
       allow_google_auth_(true) {
+  for (int i = 0; i <= brave::kUnknownEventType; ++i) {
+    auto event_type = static_cast<brave::BraveNetworkDelegateEventType>(i);
+    total_time_histograms_.push_back(
+        GetPipelineTimeHistogram(event_type, std::string(), "TotalTime"));
+    dispatch_time_histograms_.push_back(
+        GetPipelineTimeHistogram(event_type, std::string(), "DispatchTime"));
+  }
   // Initialize the preference change registrar.
   base::PostTaskWithTraits(
       FROM_HERE, {BrowserThread::UI},
@@ -161,7 +219,11 @@ void BraveNetworkDelegateBase::OnReferralHeadersChanged() {
 void BraveNetworkDelegateBase::SetReferralHeaders(
     base::ListValue* referral_headers) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  referral_headers_list_.reset(referral_headers);
+  std::unique_ptr<base::ListValue> referral_headers_list(referral_headers);
+  // Compiled once here rather than matched against the raw list for every
+  // request.
+  referral_headers_matcher_ =
+      std::make_unique<brave::ReferralHeadersMatcher>(*referral_headers_list);
 }
 
 int BraveNetworkDelegateBase::OnBeforeURLRequest(
@@ -172,10 +234,10 @@ int BraveNetworkDelegateBase::OnBeforeURLRequest(
     return ChromeNetworkDelegate::OnBeforeURLRequest(
         request, std::move(callback), new_url);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
+  std::shared_ptr<brave::BraveRequestInfo> ctx = GetRequestContext(request);
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
+  ctx->event_start_time = base::TimeTicks::Now();
   callbacks_[request->identifier()] = std::move(callback);
   RunNextCallback(request, ctx);
   return net::ERR_IO_PENDING;
@@ -189,11 +251,11 @@ int BraveNetworkDelegateBase::OnBeforeStartTransaction(
     return ChromeNetworkDelegate::OnBeforeStartTransaction(
         request, std::move(callback), headers);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
+  std::shared_ptr<brave::BraveRequestInfo> ctx = GetRequestContext(request);
   ctx->event_type = brave::kOnBeforeStartTransaction;
+  ctx->event_start_time = base::TimeTicks::Now();
   ctx->headers = headers;
-  ctx->referral_headers_list = referral_headers_list_.get();
+  ctx->referral_headers_matcher = referral_headers_matcher_.get();
   callbacks_[request->identifier()] = std::move(callback);
   RunNextCallback(request, ctx);
   return net::ERR_IO_PENDING;
@@ -214,10 +276,11 @@ int BraveNetworkDelegateBase::OnHeadersReceived(
         override_response_headers, allowed_unsafe_redirect_url);
   }
 
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  std::shared_ptr<brave::BraveRequestInfo> ctx = GetRequestContext(request);
   callbacks_[request->identifier()] = std::move(callback);
-  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
   ctx->event_type = brave::kOnHeadersReceived;
+  ctx->event_start_time = base::TimeTicks::Now();
+  ctx->pending_since = ctx->event_start_time;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
@@ -237,15 +300,17 @@ bool BraveNetworkDelegateBase::OnCanGetCookies(
     const URLRequest& request,
     const net::CookieList& cookie_list,
     bool allowed_from_caller) {
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  std::shared_ptr<brave::BraveRequestInfo> ctx = GetRequestContext(&request);
   ctx->allow_google_auth = allow_google_auth_;
-  brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
   ctx->event_type = brave::kOnCanGetCookies;
+  base::TimeTicks start_time = base::TimeTicks::Now();
   bool allow = std::all_of(can_get_cookies_callbacks_.begin(),
                            can_get_cookies_callbacks_.end(),
                            [&ctx](brave::OnCanGetCookiesCallback callback) {
                              return callback.Run(ctx);
                            });
+  RecordPipelineTime(total_time_histograms_[ctx->event_type],
+                     base::TimeTicks::Now() - start_time);
 
   base::RepeatingCallback<content::WebContents*(void)> wc_getter =
       base::BindRepeating(&GetWebContentsFromProcessAndFrameId,
@@ -264,16 +329,18 @@ bool BraveNetworkDelegateBase::OnCanSetCookie(
     const net::CanonicalCookie& cookie,
     net::CookieOptions* options,
     bool allowed_from_caller) {
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  std::shared_ptr<brave::BraveRequestInfo> ctx = GetRequestContext(&request);
   ctx->allow_google_auth = allow_google_auth_;
-  brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
   ctx->event_type = brave::kOnCanSetCookies;
+  base::TimeTicks start_time = base::TimeTicks::Now();
 
   bool allow = std::all_of(can_set_cookies_callbacks_.begin(),
                            can_set_cookies_callbacks_.end(),
                            [&ctx](brave::OnCanSetCookiesCallback callback) {
                              return callback.Run(ctx);
                            });
+  RecordPipelineTime(total_time_histograms_[ctx->event_type],
+                     base::TimeTicks::Now() - start_time);
 
   base::RepeatingCallback<content::WebContents*(void)> wc_getter =
       base::BindRepeating(&GetWebContentsFromProcessAndFrameId,
@@ -308,18 +375,27 @@ void BraveNetworkDelegateBase::RunNextCallback(
     return;
   }
 
+  OnPipelineResumed(ctx.get());
+
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
+      size_t index = ctx->next_url_request_index++;
       brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
+          before_url_request_callbacks_[index];
       brave::ResponseCallback next_callback =
           base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
                      base::Unretained(this), request, ctx);
-      rv = callback.Run(next_callback, ctx);
+      base::TimeTicks start_time = base::TimeTicks::Now();
+      {
+        TRACE_EVENT1("net", "BraveNetworkDelegateBase::RunHelper", "helper",
+                     GetHelperInfo(ctx->event_type, index).name);
+        rv = callback.Run(next_callback, ctx);
+      }
+      OnHelperReturned(ctx.get(), index, start_time, rv);
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -330,12 +406,19 @@ void BraveNetworkDelegateBase::RunNextCallback(
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
+      size_t index = ctx->next_url_request_index++;
       brave::OnBeforeStartTransactionCallback callback =
-          before_start_transaction_callbacks_[ctx->next_url_request_index++];
+          before_start_transaction_callbacks_[index];
       brave::ResponseCallback next_callback =
           base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
                      base::Unretained(this), request, ctx);
-      rv = callback.Run(request, ctx->headers, next_callback, ctx);
+      base::TimeTicks start_time = base::TimeTicks::Now();
+      {
+        TRACE_EVENT1("net", "BraveNetworkDelegateBase::RunHelper", "helper",
+                     GetHelperInfo(ctx->event_type, index).name);
+        rv = callback.Run(request, ctx->headers, next_callback, ctx);
+      }
+      OnHelperReturned(ctx.get(), index, start_time, rv);
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -345,14 +428,22 @@ void BraveNetworkDelegateBase::RunNextCallback(
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
+      size_t index = ctx->next_url_request_index++;
       brave::OnHeadersReceivedCallback callback =
-          headers_received_callbacks_[ctx->next_url_request_index++];
+          headers_received_callbacks_[index];
       brave::ResponseCallback next_callback =
           base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
                      base::Unretained(this), request, ctx);
-      rv = callback.Run(request, ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      base::TimeTicks start_time = base::TimeTicks::Now();
+      {
+        TRACE_EVENT1("net", "BraveNetworkDelegateBase::RunHelper", "helper",
+                     GetHelperInfo(ctx->event_type, index).name);
+        rv = callback.Run(request, ctx->original_response_headers,
+                          ctx->override_response_headers,
+                          ctx->allowed_unsafe_redirect_url, next_callback,
+                          ctx);
+      }
+      OnHelperReturned(ctx.get(), index, start_time, rv);
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -362,6 +453,11 @@ void BraveNetworkDelegateBase::RunNextCallback(
     }
   }
 
+  if (!ctx->event_start_time.is_null()) {
+    RecordPipelineTime(total_time_histograms_[ctx->event_type],
+                       base::TimeTicks::Now() - ctx->event_start_time);
+  }
+
   if (rv != net::OK) {
     RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
     return;
@@ -406,10 +502,137 @@ void BraveNetworkDelegateBase::RunNextCallback(
   }
 }
 
+void BraveNetworkDelegateBase::AddOnBeforeURLRequestCallback(
+    const std::string& name,
+    const brave::OnBeforeURLRequestCallback& callback) {
+  before_url_request_callbacks_.push_back(callback);
+  before_url_request_helpers_.push_back(
+      CreateHelperInfo(brave::kOnBeforeRequest, name));
+}
+
+void BraveNetworkDelegateBase::AddOnBeforeStartTransactionCallback(
+    const std::string& name,
+    const brave::OnBeforeStartTransactionCallback& callback) {
+  before_start_transaction_callbacks_.push_back(callback);
+  before_start_transaction_helpers_.push_back(
+      CreateHelperInfo(brave::kOnBeforeStartTransaction, name));
+}
+
+void BraveNetworkDelegateBase::AddOnHeadersReceivedCallback(
+    const std::string& name,
+    const brave::OnHeadersReceivedCallback& callback) {
+  headers_received_callbacks_.push_back(callback);
+  headers_received_helpers_.push_back(
+      CreateHelperInfo(brave::kOnHeadersReceived, name));
+}
+
+BraveNetworkDelegateBase::HelperInfo
+BraveNetworkDelegateBase::CreateHelperInfo(
+    brave::BraveNetworkDelegateEventType event_type,
+    const std::string& name) {
+  HelperInfo info;
+  info.name = name;
+  info.run_time = GetPipelineTimeHistogram(event_type, name, "RunTime");
+  info.pending_time = GetPipelineTimeHistogram(event_type, name, "PendingTime");
+  return info;
+}
+
+const BraveNetworkDelegateBase::HelperInfo&
+BraveNetworkDelegateBase::GetHelperInfo(
+    brave::BraveNetworkDelegateEventType event_type,
+    size_t index) const {
+  const std::vector<HelperInfo>* helpers = nullptr;
+  if (event_type == brave::kOnBeforeRequest) {
+    helpers = &before_url_request_helpers_;
+  } else if (event_type == brave::kOnBeforeStartTransaction) {
+    helpers = &before_start_transaction_helpers_;
+  } else if (event_type == brave::kOnHeadersReceived) {
+    helpers = &headers_received_helpers_;
+  }
+  if (!helpers || index >= helpers->size()) {
+    static const base::NoDestructor<HelperInfo> kUnnamed(
+        CreateHelperInfo(brave::kUnknownEventType, "Unnamed"));
+    return *kUnnamed;
+  }
+  return (*helpers)[index];
+}
+
+void BraveNetworkDelegateBase::OnHelperReturned(brave::BraveRequestInfo* ctx,
+                                                size_t index,
+                                                base::TimeTicks start_time,
+                                                int rv) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  const HelperInfo& helper = GetHelperInfo(ctx->event_type, index);
+  RecordPipelineTime(helper.run_time, now - start_time);
+  if (rv == net::ERR_IO_PENDING) {
+    ctx->pending_since = now;
+    TRACE_EVENT_ASYNC_BEGIN1("net", "BraveNetworkDelegateBase::PendingHelper",
+                             ctx, "helper", helper.name);
+  }
+}
+
+void BraveNetworkDelegateBase::OnPipelineResumed(
+    brave::BraveRequestInfo* ctx) {
+  if (ctx->pending_since.is_null()) {
+    return;
+  }
+  base::TimeDelta pending_time = base::TimeTicks::Now() - ctx->pending_since;
+  ctx->pending_since = base::TimeTicks();
+  // Nothing has run yet when the whole event was posted to the IO thread, so
+  // the time is the dispatch delay rather than a helper's.
+  if (ctx->next_url_request_index == 0) {
+    RecordPipelineTime(dispatch_time_histograms_[ctx->event_type],
+                       pending_time);
+    return;
+  }
+  const HelperInfo& helper =
+      GetHelperInfo(ctx->event_type, ctx->next_url_request_index - 1);
+  RecordPipelineTime(helper.pending_time, pending_time);
+  TRACE_EVENT_ASYNC_END1("net", "BraveNetworkDelegateBase::PendingHelper",
+                         ctx, "helper", helper.name);
+}
+
+std::shared_ptr<brave::BraveRequestInfo>
+BraveNetworkDelegateBase::GetRequestContext(const URLRequest* request) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  auto it = contexts_.find(request->identifier());
+  if (it != contexts_.end()) {
+    // Only reuse the context if no task from an earlier stage still holds
+    // it and the request wasn't redirected since it was filled.
+    if (it->second.use_count() == 1 &&
+        brave::BraveRequestInfo::CanReuseCTXForRequest(request, it->second)) {
+      it->second->ResetStageState();
+      it->second->request = request;
+      return it->second;
+    }
+    contexts_.erase(it);
+  }
+
+  std::shared_ptr<brave::BraveRequestInfo> ctx;
+  if (!context_pool_.empty()) {
+    ctx = std::move(context_pool_.back());
+    context_pool_.pop_back();
+  } else {
+    ctx = std::make_shared<brave::BraveRequestInfo>();
+  }
+  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
+  contexts_[request->identifier()] = ctx;
+  return ctx;
+}
+
 void BraveNetworkDelegateBase::OnURLRequestDestroyed(URLRequest* request) {
   if (ContainsKey(callbacks_, request->identifier())) {
     callbacks_.erase(request->identifier());
   }
+  auto it = contexts_.find(request->identifier());
+  if (it != contexts_.end()) {
+    if (it->second.use_count() == 1 &&
+        context_pool_.size() < kMaxPooledRequestContexts) {
+      it->second->Reset();
+      context_pool_.push_back(std::move(it->second));
+    }
+    contexts_.erase(it);
+  }
   ChromeNetworkDelegate::OnURLRequestDestroyed(request);
 }
 
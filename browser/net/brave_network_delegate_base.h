@@ -20,6 +20,14 @@
 
 class PrefChangeRegistrar;
 
+namespace base {
+class HistogramBase;
+}
+
+namespace brave {
+class ReferralHeadersMatcher;
+}
+
 namespace extensions {
 class EventRouterForwarder;
 }
@@ -78,6 +86,16 @@ class BraveNetworkDelegateBase : public ChromeNetworkDelegate {
  protected:
   void RunNextCallback(net::URLRequest* request,
                        std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // |name| labels the helper's latency histograms and trace events.
+  void AddOnBeforeURLRequestCallback(
+      const std::string& name,
+      const brave::OnBeforeURLRequestCallback& callback);
+  void AddOnBeforeStartTransactionCallback(
+      const std::string& name,
+      const brave::OnBeforeStartTransactionCallback& callback);
+  void AddOnHeadersReceivedCallback(
+      const std::string& name,
+      const brave::OnHeadersReceivedCallback& callback);
   std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
@@ -86,6 +104,33 @@ class BraveNetworkDelegateBase : public ChromeNetworkDelegate {
   std::vector<brave::OnCanSetCookiesCallback> can_set_cookies_callbacks_;
 
  private:
+  // Returns the context of |request|, reusing the one filled by an earlier
+  // pipeline stage when it still applies.
+  std::shared_ptr<brave::BraveRequestInfo> GetRequestContext(
+      const net::URLRequest* request);
+  // A registered helper's name and its latency histograms, which are looked
+  // up once here rather than by name on every request.
+  struct HelperInfo {
+    std::string name;
+    base::HistogramBase* run_time;
+    base::HistogramBase* pending_time;
+  };
+
+  static HelperInfo CreateHelperInfo(
+      brave::BraveNetworkDelegateEventType event_type,
+      const std::string& name);
+  const HelperInfo& GetHelperInfo(
+      brave::BraveNetworkDelegateEventType event_type,
+      size_t index) const;
+  // Records how long the helper at |index| ran before returning |rv|, and
+  // marks the start of its pending time if it went asynchronous.
+  void OnHelperReturned(brave::BraveRequestInfo* ctx,
+                        size_t index,
+                        base::TimeTicks start_time,
+                        int rv);
+  // Records the time since |ctx| was last handed to a helper or task runner
+  // that returned ERR_IO_PENDING.
+  void OnPipelineResumed(brave::BraveRequestInfo* ctx);
   void InitPrefChangeRegistrarOnUI();
   void SetReferralHeaders(base::ListValue* referral_headers);
   void OnReferralHeadersChanged();
@@ -97,8 +142,19 @@ class BraveNetworkDelegateBase : public ChromeNetworkDelegate {
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+  std::unique_ptr<brave::ReferralHeadersMatcher> referral_headers_matcher_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  // Helper names and histograms, parallel to the callback lists above.
+  std::vector<HelperInfo> before_url_request_helpers_;
+  std::vector<HelperInfo> before_start_transaction_helpers_;
+  std::vector<HelperInfo> headers_received_helpers_;
+  // Whole-event histograms, indexed by brave::BraveNetworkDelegateEventType.
+  std::vector<base::HistogramBase*> total_time_histograms_;
+  std::vector<base::HistogramBase*> dispatch_time_histograms_;
+  // One context per live request, shared by all pipeline stages.
+  std::map<uint64_t, std::shared_ptr<brave::BraveRequestInfo>> contexts_;
+  // Contexts of destroyed requests, recycled to avoid allocator churn.
+  std::vector<std::shared_ptr<brave::BraveRequestInfo>> context_pool_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
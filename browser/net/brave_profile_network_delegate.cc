@@ -24,43 +24,28 @@
 BraveProfileNetworkDelegate::BraveProfileNetworkDelegate(
     extensions::EventRouterForwarder* event_router) :
     BraveNetworkDelegateBase(event_router) {
-  brave::OnBeforeURLRequestCallback
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
-
+  AddOnBeforeURLRequestCallback("SiteHacks",
+      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork));
+  AddOnBeforeURLRequestCallback("AdBlockTP",
+      base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork));
+  AddOnBeforeURLRequestCallback("HTTPSE",
+      base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork));
+  AddOnBeforeURLRequestCallback("CommonStaticRedirect",
+      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddOnBeforeURLRequestCallback("Rewards",
+      base::Bind(brave_rewards::OnBeforeURLRequest));
 #endif
+  AddOnBeforeURLRequestCallback("Tor",
+      base::Bind(brave::OnBeforeURLRequest_TorWork));
 
-  callback = base::Bind(brave::OnBeforeURLRequest_TorWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
-
-  start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddOnBeforeStartTransactionCallback("SiteHacks",
+      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork));
+  AddOnBeforeStartTransactionCallback("Referrals",
+      base::Bind(brave::OnBeforeStartTransaction_ReferralsWork));
 
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::Bind(
-          webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  AddOnHeadersReceivedCallback("TorrentRedirect",
+      base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork));
 
   brave::OnCanGetCookiesCallback get_cookies_callback =
       base::Bind(brave::OnCanGetCookiesForBraveShields);
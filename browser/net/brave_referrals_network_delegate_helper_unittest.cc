@@ -7,6 +7,7 @@
 #include "base/json/json_reader.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "net/url_request/url_request_test_util.h"
@@ -82,7 +83,8 @@ TEST_F(BraveReferralsNetworkDelegateHelperTest, ReplaceHeadersForMatchingDomain)
   brave::ResponseCallback callback;
   std::shared_ptr<brave::BraveRequestInfo> brave_request_info(
       new brave::BraveRequestInfo());
-  brave_request_info->referral_headers_list = &referral_headers_list;
+  brave::ReferralHeadersMatcher matcher(referral_headers_list);
+  brave_request_info->referral_headers_matcher = &matcher;
   int ret = brave::OnBeforeStartTransaction_ReferralsWork(
       request.get(), &headers, callback, brave_request_info);
 
@@ -115,7 +117,8 @@ TEST_F(BraveReferralsNetworkDelegateHelperTest, NoReplaceHeadersForNonMatchingDo
   brave::ResponseCallback callback;
   std::shared_ptr<brave::BraveRequestInfo> brave_request_info(
       new brave::BraveRequestInfo());
-  brave_request_info->referral_headers_list = &referral_headers_list;
+  brave::ReferralHeadersMatcher matcher(referral_headers_list);
+  brave_request_info->referral_headers_matcher = &matcher;
   int ret = brave::OnBeforeStartTransaction_ReferralsWork(
       request.get(), &headers, callback, brave_request_info);
 
@@ -11,6 +11,7 @@
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/common/url_constants.h"
+#include "brave/common/url_rule_table.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -35,15 +36,10 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx,
   if (tab_origin.SchemeIs(kChromeExtensionScheme)) {
     return false;
   }
-  bool allow_referrers = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kReferrers);
-  bool shields_up = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields);
   const std::string original_referrer = request->referrer();
   Referrer new_referrer;
-  if (brave_shields::ShouldSetReferrer(allow_referrers, shields_up,
+  if (brave_shields::ShouldSetReferrer(ctx->allow_referrers,
+          ctx->allow_brave_shields,
           GURL(original_referrer), tab_origin, request->url(), target_origin,
           Referrer::NetReferrerPolicyToBlinkReferrerPolicy(
               request->referrer_policy()), &new_referrer)) {
@@ -53,6 +49,42 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx,
   return false;
 }
 
+enum SiteHackRule {
+  kForbesRule,
+  kTwitterRedirectRule,
+  kTwitterReferrerRule,
+};
+
+const URLRuleTable& GetSiteHackRules() {
+  static const URLRuleTable* rules = [] {
+    URLRuleTable* table = new URLRuleTable();
+    table->AddRule(kForbesRule, URLPattern::SCHEME_ALL, kForbesPattern);
+    table->AddRule(kTwitterRedirectRule, URLPattern::SCHEME_ALL,
+                   kTwitterRedirectURL);
+    table->AddRule(kTwitterReferrerRule, URLPattern::SCHEME_ALL,
+                   kTwitterReferrer);
+    return table;
+  }();
+  return *rules;
+}
+
+void ApplyCookieOverride(net::HttpRequestHeaders* headers,
+                         const std::string& extra_cookies) {
+  std::string cookies;
+  if (headers->GetHeader(kCookieHeader, &cookies)) {
+    cookies = "; ";
+  }
+  cookies += extra_cookies;
+  headers->SetHeader(kCookieHeader, cookies);
+}
+
+bool HasTwitterReferrer(net::HttpRequestHeaders* headers) {
+  std::string referrer;
+  return headers->GetHeader(kRefererHeader, &referrer) &&
+         (GetSiteHackRules().Match(GURL(referrer)) &
+          URLRuleTable::MaskForRule(kTwitterReferrerRule));
+}
+
 }  // namespace
 
 int OnBeforeURLRequest_SiteHacksWork(
@@ -62,40 +94,17 @@ int OnBeforeURLRequest_SiteHacksWork(
   return net::OK;
 }
 
-void CheckForCookieOverride(const GURL& url, const URLPattern& pattern,
-    net::HttpRequestHeaders* headers, const std::string& extra_cookies) {
-  if (pattern.MatchesURL(url)) {
-    std::string cookies;
-    if (headers->GetHeader(kCookieHeader, &cookies)) {
-      cookies = "; ";
-    }
-    cookies += extra_cookies;
-    headers->SetHeader(kCookieHeader, cookies);
-  }
-}
-
-bool IsBlockTwitterSiteHack(net::URLRequest* request,
-    net::HttpRequestHeaders* headers) {
-  URLPattern redirectURLPattern(URLPattern::SCHEME_ALL, kTwitterRedirectURL);
-  URLPattern referrerPattern(URLPattern::SCHEME_ALL, kTwitterReferrer);
-  if (redirectURLPattern.MatchesURL(request->url())) {
-    std::string referrer;
-    if (headers->GetHeader(kRefererHeader, &referrer) &&
-        referrerPattern.MatchesURL(GURL(referrer))) {
-      return true;
-    }
-  }
-  return false;
-}
-
 int OnBeforeStartTransaction_SiteHacksWork(net::URLRequest* request,
         net::HttpRequestHeaders* headers,
         const ResponseCallback& next_callback,
         std::shared_ptr<BraveRequestInfo> ctx) {
-  CheckForCookieOverride(request->url(),
-      URLPattern(URLPattern::SCHEME_ALL, kForbesPattern), headers,
-      kForbesExtraCookies);
-  if (IsBlockTwitterSiteHack(request, headers)) {
+  const URLRuleTable::RuleMask matches =
+      GetSiteHackRules().Match(request->url());
+  if (matches & URLRuleTable::MaskForRule(kForbesRule)) {
+    ApplyCookieOverride(headers, kForbesExtraCookies);
+  }
+  if ((matches & URLRuleTable::MaskForRule(kTwitterRedirectRule)) &&
+      HasTwitterReferrer(headers)) {
     return net::ERR_ABORTED;
   }
   if (IsUAWhitelisted(request->url())) {
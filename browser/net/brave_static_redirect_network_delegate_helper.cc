@@ -6,62 +6,114 @@
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
 #include <memory>
-#include <vector>
 
 #include "brave/common/network_constants.h"
+#include "brave/common/url_rule_table.h"
 #include "extensions/common/url_pattern.h"
 
 namespace brave {
 
+namespace {
+
+enum StaticRedirectRule {
+  kGeoLocationRule,
+  kSafeBrowsingRule,
+  kCRXDownloadRule,
+  kCRLSetRule,
+};
+
+const URLRuleTable& GetStaticRedirectRules() {
+  static const URLRuleTable* rules = [] {
+    URLRuleTable* table = new URLRuleTable();
+    table->AddRule(kGeoLocationRule, URLPattern::SCHEME_HTTPS,
+                   kGeoLocationsPattern);
+    table->AddHostRule(kSafeBrowsingRule, URLPattern::SCHEME_HTTPS,
+                       kSafeBrowsingPrefix);
+    const int http_schemes = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+    table->AddRule(kCRXDownloadRule, http_schemes, kCRXDownloadPrefix);
+    table->AddRule(kCRLSetRule, http_schemes, kCRLSetPrefix1);
+    table->AddRule(kCRLSetRule, http_schemes, kCRLSetPrefix2);
+    table->AddRule(kCRLSetRule, http_schemes, kCRLSetPrefix3);
+    return table;
+  }();
+  return *rules;
+}
+
+#if !defined(NDEBUG)
+const URLRuleTable& GetAllowedSystemRequestRules() {
+  static const URLRuleTable* rules = [] {
+    URLRuleTable* table = new URLRuleTable();
+    for (const char* pattern : {
+        // Brave updates
+        "https://go-updater.brave.com/*",
+        // Brave promo referrals, production and staging (laptop-updates
+        // proxies to promo-services)
+        // TODO(@emerick): In the future, we may want to specify the value of
+        // the BRAVE_REFERRALS_SERVER environment variable rather than
+        // hardcoding the server name here
+        "https://laptop-updates.brave.com/*",
+        "https://laptop-updates-staging.herokuapp.com/*",
+        // CRX file download
+        "https://brave-core-ext.s3.brave.com/release/*",
+        // Safe Browsing and other files
+        "https://static.brave.com/*",
+        // We do allow redirects to the Google update server for extensions we
+        // don't support
+        "https://update.googleapis.com/service/update2",
+
+        // Rewards URLs
+        "https://ledger.mercury.basicattentiontoken.org/*",
+        "https://balance.mercury.basicattentiontoken.org/*",
+        "https://publishers.basicattentiontoken.org/*",
+        "https://publishers-distro.basicattentiontoken.org/*",
+        "https://ledger-staging.mercury.basicattentiontoken.org/*",
+        "https://balance-staging.mercury.basicattentiontoken.org/*",
+        "https://publishers-staging.basicattentiontoken.org/*",
+        "https://publishers-staging-distro.basicattentiontoken.org/*",
+
+        // Safe browsing
+        "https://safebrowsing.brave.com/v4/*",
+        "https://ssl.gstatic.com/safebrowsing/*",
+
+        "https://crlsets.brave.com/*",
+        "https://crxdownload.brave.com/*",
+    }) {
+      table->AddRule(0, URLPattern::SCHEME_HTTPS, pattern);
+    }
+    return table;
+  }();
+  return *rules;
+}
+#endif
+
+}  // namespace
+
 int OnBeforeURLRequest_StaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
   GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-
-  if (geo_pattern.MatchesURL(ctx->request_url)) {
+  const URLRuleTable::RuleMask matches =
+      GetStaticRedirectRules().Match(ctx->request_url);
+
+  if (matches & URLRuleTable::MaskForRule(kGeoLocationRule)) {
     ctx->new_url_spec = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY).spec();
     return net::OK;
   }
 
-  if (safeBrowsing_pattern.MatchesHost(ctx->request_url)) {
+  if (matches & URLRuleTable::MaskForRule(kSafeBrowsingRule)) {
     replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
     ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
     return net::OK;
   }
 
-  if (crxDownload_pattern.MatchesURL(ctx->request_url)) {
+  if (matches & URLRuleTable::MaskForRule(kCRXDownloadRule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crxdownload.brave.com");
     ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
     return net::OK;
   }
 
-  if (crlSet_pattern1.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
-  }
-
-  if (crlSet_pattern3.MatchesURL(ctx->request_url)) {
+  if (matches & URLRuleTable::MaskForRule(kCRLSetRule)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
@@ -70,67 +122,9 @@ int OnBeforeURLRequest_StaticRedirectWork(
 
 #if !defined(NDEBUG)
   GURL gurl = ctx->request_url;
-  static std::vector<URLPattern> allowed_patterns({
-      // Brave updates
-      URLPattern(URLPattern::SCHEME_HTTPS, "https://go-updater.brave.com/*"),
-      // Brave promo referrals, production and staging (laptop-updates
-      // proxies to promo-services)
-      // TODO(@emerick): In the future, we may want to specify the value of the
-      // BRAVE_REFERRALS_SERVER environment variable rather than
-      // hardcoding the server name here
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://laptop-updates.brave.com/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://laptop-updates-staging.herokuapp.com/*"),
-      // CRX file download
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://brave-core-ext.s3.brave.com/release/*"),
-      // Safe Browsing and other files
-      URLPattern(URLPattern::SCHEME_HTTPS, "https://static.brave.com/*"),
-      // We do allow redirects to the Google update server for extensions we
-      // don't support
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://update.googleapis.com/service/update2"),
-
-      // Rewards URLs
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://ledger.mercury.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://balance.mercury.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://publishers.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://publishers-distro.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://ledger-staging.mercury.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://balance-staging.mercury.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://publishers-staging.basicattentiontoken.org/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://publishers-staging-distro.basicattentiontoken.org/*"),
-
-      // Safe browsing
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://safebrowsing.brave.com/v4/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS,
-                 "https://ssl.gstatic.com/safebrowsing/*"),
-
-      URLPattern(URLPattern::SCHEME_HTTPS, "https://crlsets.brave.com/*"),
-      URLPattern(URLPattern::SCHEME_HTTPS, "https://crxdownload.brave.com/*"),
-  });
-
   // Check to make sure the URL being requested matches at least one of the
   // allowed patterns
-  bool is_url_allowed =
-      std::any_of(allowed_patterns.begin(), allowed_patterns.end(),
-                  [&gurl](URLPattern pattern) {
-                    if (pattern.MatchesURL(gurl)) {
-                      return true;
-                    }
-                    return false;
-                  });
-  if (!is_url_allowed) {
+  if (!GetAllowedSystemRequestRules().Match(gurl)) {
     LOG(ERROR) << "URL not allowed from system network delegate: " << gurl;
   }
   // TODO(@bbondy): Before we can turn this into DCHECK we have to find a way to
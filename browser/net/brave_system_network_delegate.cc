@@ -10,13 +10,10 @@
 BraveSystemNetworkDelegate::BraveSystemNetworkDelegate(
     extensions::EventRouterForwarder* event_router) :
     BraveNetworkDelegateBase(event_router) {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(
-          brave::OnBeforeURLRequest_StaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
-  callback = base::Bind(
-          brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddOnBeforeURLRequestCallback("StaticRedirect",
+      base::Bind(brave::OnBeforeURLRequest_StaticRedirectWork));
+  AddOnBeforeURLRequestCallback("CommonStaticRedirect",
+      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 }
 
 BraveSystemNetworkDelegate::~BraveSystemNetworkDelegate() {
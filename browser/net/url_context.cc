@@ -20,7 +20,7 @@
 
 namespace brave {
 
-BraveRequestInfo::BraveRequestInfo() {
+BraveRequestInfo::BraveRequestInfo() : request(nullptr) {
 }
 
 BraveRequestInfo::~BraveRequestInfo() {
@@ -30,6 +30,7 @@ void BraveRequestInfo::FillCTXFromRequest(const net::URLRequest* request,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   ctx->request_identifier = request->identifier();
   ctx->request_url = request->url();
+  ctx->site_for_cookies = request->site_for_cookies();
   auto* request_info = content::ResourceRequestInfo::ForRequest(request);
   if (request_info) {
     ctx->resource_type = request_info->GetResourceType();
@@ -49,24 +50,64 @@ void BraveRequestInfo::FillCTXFromRequest(const net::URLRequest* request,
                                      ctx->frame_tree_node_id).GetOrigin();
   }
   ctx->tab_origin = ctx->tab_url.GetOrigin();
-  ctx->allow_brave_shields = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, ctx->tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields) &&
+  // All shields settings for the tab are resolved together and cached per
+  // tab origin, see ShieldsSettingsCache.
+  brave_shields::ShieldsSettings settings =
+      brave_shields::GetShieldsSettingsFromIO(request, ctx->tab_origin);
+  ctx->allow_brave_shields = settings.allow_brave_shields &&
     !request->site_for_cookies().SchemeIs(kChromeExtensionScheme);
-  ctx->allow_ads = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, ctx->tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kAds);
+  ctx->allow_ads = settings.allow_ads;
   ctx->allow_http_upgradable_resource =
-      brave_shields::IsAllowContentSettingFromIO(request, ctx->tab_origin,
-          ctx->tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kHTTPUpgradableResources);
-  ctx->allow_1p_cookies = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, GURL("https://firstParty/"),
-      CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kCookies);
-  ctx->allow_3p_cookies = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kCookies);
+      settings.allow_http_upgradable_resource;
+  ctx->allow_1p_cookies = settings.allow_1p_cookies;
+  ctx->allow_3p_cookies = settings.allow_3p_cookies;
+  ctx->allow_referrers = settings.allow_referrers;
   ctx->request = request;
 }
 
+// static
+bool BraveRequestInfo::CanReuseCTXForRequest(const net::URLRequest* request,
+    const std::shared_ptr<brave::BraveRequestInfo>& ctx) {
+  return ctx->request_identifier == request->identifier() &&
+      ctx->request_url == request->url() &&
+      ctx->site_for_cookies == request->site_for_cookies();
+}
+
+void BraveRequestInfo::ResetStageState() {
+  new_url_spec.clear();
+  next_url_request_index = 0;
+  headers = nullptr;
+  original_response_headers = nullptr;
+  override_response_headers = nullptr;
+  allowed_unsafe_redirect_url = nullptr;
+  event_type = kUnknownEventType;
+  referral_headers_matcher = nullptr;
+  blocked_by = kNotBlocked;
+  cancel_request_explicitly = false;
+  new_url = nullptr;
+  event_start_time = base::TimeTicks();
+  pending_since = base::TimeTicks();
+}
+
+void BraveRequestInfo::Reset() {
+  ResetStageState();
+  request_url = GURL();
+  tab_origin = GURL();
+  tab_url = GURL();
+  site_for_cookies = GURL();
+  allow_brave_shields = true;
+  allow_ads = false;
+  allow_http_upgradable_resource = false;
+  allow_1p_cookies = true;
+  allow_3p_cookies = false;
+  allow_referrers = false;
+  allow_google_auth = true;
+  render_process_id = 0;
+  render_frame_id = 0;
+  frame_tree_node_id = 0;
+  request_identifier = 0;
+  resource_type = content::RESOURCE_TYPE_LAST_TYPE;
+  request = nullptr;
+}
+
 }  // namespace brave
@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 
+#include "base/time/time.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "content/public/common/resource_type.h"
 #include "net/url_request/url_request.h"
@@ -19,6 +20,7 @@ class BraveNetworkDelegateBase;
 
 namespace brave {
 
+class ReferralHeadersMatcher;
 struct BraveRequestInfo;
 using ResponseCallback = base::Callback<void()>;
 
@@ -60,6 +62,7 @@ struct BraveRequestInfo {
   bool allow_http_upgradable_resource = false;
   bool allow_1p_cookies = true;
   bool allow_3p_cookies = false;
+  bool allow_referrers = false;
   bool allow_google_auth = true;
   int render_process_id = 0;
   int render_frame_id = 0;
@@ -71,16 +74,35 @@ struct BraveRequestInfo {
   scoped_refptr<net::HttpResponseHeaders>* override_response_headers = nullptr;
   GURL* allowed_unsafe_redirect_url = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
-  const base::ListValue* referral_headers_list = nullptr;
+  const ReferralHeadersMatcher* referral_headers_matcher = nullptr;
   BlockedBy blocked_by = kNotBlocked;
   bool cancel_request_explicitly = false;
   // Default to invalid type for resource_type, so delegate helpers
   // can properly detect that the info couldn't be obtained.
   content::ResourceType resource_type = content::RESOURCE_TYPE_LAST_TYPE;
 
+  // Tab and settings information is only valid for this pair; a redirect
+  // changes it.
+  GURL site_for_cookies;
+
+  // When the current event entered the pipeline, and when the helper that is
+  // running now returned ERR_IO_PENDING. Used for the latency histograms.
+  base::TimeTicks event_start_time;
+  base::TimeTicks pending_since;
+
   static void FillCTXFromRequest(const net::URLRequest* request,
     std::shared_ptr<brave::BraveRequestInfo> ctx);
 
+  // Returns true if |ctx| was filled from |request| and still describes it,
+  // so a later pipeline stage can reuse it instead of filling a new one.
+  static bool CanReuseCTXForRequest(const net::URLRequest* request,
+    const std::shared_ptr<brave::BraveRequestInfo>& ctx);
+
+  // Clears the state that only applies to a single pipeline stage.
+  void ResetStageState();
+  // Clears everything so the object can be recycled for another request.
+  void Reset();
+
  private:
   // Please don't add any more friends here if it can be avoided.
   // We should also remove the ones below.
@@ -29,7 +29,6 @@ class MockTorProfileServiceImpl : public TorProfileService {
                bool new_circuit) override;
 
  private:
-  Profile* profile_;  // NOT OWNED
   TorConfig config_;
   DISALLOW_COPY_AND_ASSIGN(MockTorProfileServiceImpl);
 };
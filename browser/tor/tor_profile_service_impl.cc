@@ -26,7 +26,8 @@ using content::SiteInstance;
 namespace tor {
 
 TorProfileServiceImpl::TorProfileServiceImpl(Profile* profile) :
-    profile_(profile) {
+    profile_(profile),
+    proxy_delegate_(base::MakeRefCounted<TorProxyDelegate>()) {
   tor_launcher_factory_ = TorLauncherFactory::GetInstance();
   tor_launcher_factory_->AddObserver(this);
 }
@@ -60,7 +61,7 @@ void TorProfileServiceImpl::SetNewTorCircuitOnIOThread(
   TorProxyConfigService::TorSetProxy(proxy_resolution_service,
                                      tor_config.proxy_string(),
                                      host,
-                                     &tor_proxy_map_,
+                                     proxy_delegate_.get(),
                                      true);
 }
 
@@ -99,7 +100,6 @@ int TorProfileServiceImpl::SetProxy(net::ProxyResolutionService* service,
                                     bool new_circuit) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   const TorConfig tor_config = tor_launcher_factory_->GetTorConfig();
-  GURL url = SiteInstance::GetSiteForURL(profile_, request_url);
   if (tor_config.empty()) {
     // No tor config => we absolutely cannot talk to the network.
     // This might mean that there was a problem trying to initialize
@@ -107,10 +107,12 @@ int TorProfileServiceImpl::SetProxy(net::ProxyResolutionService* service,
     LOG(ERROR) << "Tor not configured -- blocking connection";
     return net::ERR_SOCKS_CONNECTION_FAILED;
   }
-  base::PostTaskWithTraits(FROM_HERE, {BrowserThread::IO},
-      base::Bind(&TorProxyConfigService::TorSetProxy,
+  // The credentials of each site are picked when its requests resolve their
+  // proxy, so this only installs the Tor proxy config on first use.
+  TorProxyConfigService::TorSetProxy(
       service, tor_config.proxy_string(),
-      url.host(), &tor_proxy_map_, new_circuit));
+      TorProxyConfigService::GetIsolationUsername(request_url),
+      proxy_delegate_.get(), new_circuit);
   return net::OK;
 }
 
@@ -55,7 +55,9 @@ class TorProfileServiceImpl : public TorProfileService,
 
   Profile* profile_;  // NOT OWNED
   TorLauncherFactory* tor_launcher_factory_;  // Singleton
-  TorProxyConfigService::TorProxyMap tor_proxy_map_;
+  // Isolates the streams of this profile. It goes away with the profile, so
+  // the next Tor profile starts with new credentials.
+  scoped_refptr<TorProxyDelegate> proxy_delegate_;
   DISALLOW_COPY_AND_ASSIGN(TorProfileServiceImpl);
 };
 
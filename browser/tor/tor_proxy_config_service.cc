@@ -16,8 +16,13 @@
 #include "base/strings/string_util.h"
 #include "content/public/browser/browser_thread.h"
 #include "crypto/random.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/proxy_server.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "net/proxy_resolution/proxy_info.h"
 #include "net/proxy_resolution/proxy_resolution_service.h"
 #include "net/url_request/url_request_context.h"
+#include "url/gurl.h"
 #include "url/third_party/mozilla/url_parse.h"
 
 namespace tor {
@@ -28,8 +33,12 @@ const int kTorPasswordLength = 16;
 constexpr base::TimeDelta kTenMins = base::TimeDelta::FromMinutes(10);
 
 TorProxyConfigService::TorProxyConfigService(
-  const std::string& tor_proxy, const std::string& username,
-  TorProxyMap* tor_proxy_map) {
+  const std::string& tor_proxy,
+  net::ProxyResolutionService* service,
+  TorProxyDelegate* delegate)
+    : service_(service), delegate_(delegate) {
+    if (delegate_)
+      delegate_->AddConfigService(service_);
     if (tor_proxy.length()) {
       url::Parsed url;
       url::ParseStandardURL(
@@ -48,35 +57,61 @@ TorProxyConfigService::TorProxyConfigService(
       }
       if (scheme_.empty() || host_.empty() || port_.empty())
         return;
-      std::string proxy_url;
-      if (tor_proxy_map && !username.empty()) {
-        std::string password = tor_proxy_map->Get(username);
-        proxy_url = std::string(scheme_ + "://" + username + ":" + password +
-                                "@" + host_ + ":" + port_);
-      } else {
-        proxy_url = std::string(scheme_ + "://" + host_ + ":" + port_);
-      }
+      // Credentials are added per request in OnResolveProxy.
+      std::string proxy_url =
+          std::string(scheme_ + "://" + host_ + ":" + port_);
       config_.proxy_rules().ParseFromString(proxy_url);
     }
 }
 
-TorProxyConfigService::~TorProxyConfigService() {}
+TorProxyConfigService::~TorProxyConfigService() {
+  if (delegate_)
+    delegate_->RemoveConfigService(service_);
+}
 
 // static
 void TorProxyConfigService::TorSetProxy(
     net::ProxyResolutionService* service,
-    std::string tor_proxy,
-    std::string site_url,
-    TorProxyMap* tor_proxy_map,
+    const std::string& tor_proxy,
+    const std::string& site_url,
+    TorProxyDelegate* delegate,
     bool new_password) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   if (!service)
     return;
-  if (new_password && tor_proxy_map)
-    tor_proxy_map->Erase(site_url);
+  if (new_password && delegate)
+    delegate->tor_proxy_map()->Erase(site_url);
+
+  // Usually |service| already uses |tor_proxy|, and comparing its URI is
+  // all the work done for a request.
+  const base::Optional<net::ProxyConfigWithAnnotation>& current_config =
+      service->config();
+  const net::ProxyConfig::ProxyRules* current_rules =
+      current_config ? &current_config->value().proxy_rules() : nullptr;
+  if (current_rules && !current_rules->single_proxies.IsEmpty() &&
+      current_rules->single_proxies.Get().ToURI() == tor_proxy) {
+    return;
+  }
+
+  const bool install_delegate = delegate && !delegate->IsInstalledOn(service);
   std::unique_ptr<TorProxyConfigService>
-    config(new TorProxyConfigService(tor_proxy, site_url, tor_proxy_map));
+    config(new TorProxyConfigService(tor_proxy, service, delegate));
+  if (current_rules && current_rules->Equals(config->config_.proxy_rules()))
+    return;
   service->ResetConfigService(std::move(config));
+  // The delegate doesn't depend on the config service, so it stays installed
+  // when the config is replaced. SetProxyDelegate() DCHECKs that |service|
+  // has no other delegate.
+  if (install_delegate)
+    service->SetProxyDelegate(delegate);
+}
+
+// static
+std::string TorProxyConfigService::GetIsolationUsername(const GURL& url) {
+  // This matches the host of SiteInstance::GetSiteForURL for web URLs.
+  std::string domain = net::registry_controlled_domains::GetDomainAndRegistry(
+      url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  return domain.empty() ? url.host() : domain;
 }
 
 TorProxyConfigService::ConfigAvailability
@@ -88,6 +123,56 @@ TorProxyConfigService::ConfigAvailability
   return CONFIG_VALID;
 }
 
+TorProxyDelegate::TorProxyDelegate() = default;
+
+TorProxyDelegate::~TorProxyDelegate() = default;
+
+bool TorProxyDelegate::IsInstalledOn(
+    net::ProxyResolutionService* service) const {
+  return config_services_.find(service) != config_services_.end();
+}
+
+void TorProxyDelegate::AddConfigService(
+    net::ProxyResolutionService* service) {
+  config_services_[service]++;
+}
+
+void TorProxyDelegate::RemoveConfigService(
+    net::ProxyResolutionService* service) {
+  auto it = config_services_.find(service);
+  DCHECK(it != config_services_.end());
+  if (--it->second == 0)
+    config_services_.erase(it);
+}
+
+void TorProxyDelegate::OnResolveProxy(
+    const GURL& url,
+    const std::string& method,
+    const net::ProxyRetryInfoMap& proxy_retry_info,
+    net::ProxyInfo* result) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (result->is_empty() || result->is_direct())
+    return;
+  const net::ProxyServer& proxy_server = result->proxy_server();
+  if (proxy_server.scheme() != net::ProxyServer::SCHEME_SOCKS5)
+    return;
+  const std::string username =
+      TorProxyConfigService::GetIsolationUsername(url);
+  if (username.empty())
+    return;
+  const net::HostPortPair& host_port_pair = proxy_server.host_port_pair();
+  result->UseProxyServer(net::ProxyServer(
+      proxy_server.scheme(),
+      net::HostPortPair(username, tor_proxy_map_.Get(username),
+                        host_port_pair.host(), host_port_pair.port())));
+}
+
+net::Error TorProxyDelegate::OnTunnelHeadersReceived(
+    const net::ProxyServer& proxy_server,
+    const net::HttpResponseHeaders& response_headers) {
+  return net::OK;
+}
+
 TorProxyConfigService::TorProxyMap::TorProxyMap() = default;
 TorProxyConfigService::TorProxyMap::~TorProxyMap() {
   timer_.Stop();
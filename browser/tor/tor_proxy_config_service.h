@@ -11,12 +11,19 @@
 #include <utility>
 
 #include "base/compiler_specific.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/timer/timer.h"
+#include "content/public/browser/browser_thread.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_export.h"
+#include "net/base/proxy_delegate.h"
 #include "net/proxy_resolution/proxy_config.h"
 #include "net/proxy_resolution/proxy_config_service.h"
 
+class GURL;
+
 namespace base {
 class Time;
 }
@@ -29,7 +36,13 @@ namespace tor {
 
 const char kSocksProxy[] = "socks5";
 
+class TorProxyDelegate;
+
 // Implementation of ProxyConfigService that returns a tor specific result.
+// It is installed once per ProxyResolutionService, together with a
+// TorProxyDelegate that gives each request the SOCKS credentials of its site
+// when its proxy is resolved. Requests to different sites therefore share one
+// config and never reset the service.
 class TorProxyConfigService : public net::ProxyConfigService {
  public:
   // Used to cache <username, password> of proxies
@@ -50,18 +63,29 @@ class TorProxyConfigService : public net::ProxyConfigService {
     DISALLOW_COPY_AND_ASSIGN(TorProxyMap);
   };
 
-  explicit TorProxyConfigService(const std::string& tor_proxy,
-                                 const std::string& username,
-                                 TorProxyMap* map);
+  // |delegate| may be null. Otherwise it is told that |service| uses this
+  // config until it is destroyed, and is kept alive until then.
+  TorProxyConfigService(const std::string& tor_proxy,
+                        net::ProxyResolutionService* service,
+                        TorProxyDelegate* delegate);
   ~TorProxyConfigService() override;
 
+  // Makes |service| proxy through |tor_proxy|. This only replaces the config
+  // service when |service| isn't using |tor_proxy| yet, so it is cheap to
+  // call for every request. |delegate| is installed on |service| unless it is
+  // null, and |new_password| drops its credentials for |site_url| so that the
+  // next request of that site gets a new circuit.
   static void TorSetProxy(
     net::ProxyResolutionService* service,
-    std::string tor_proxy,
-    std::string site_url,
-    TorProxyMap* tor_proxy_map,
+    const std::string& tor_proxy,
+    const std::string& site_url,
+    TorProxyDelegate* delegate,
     bool new_password);
 
+  // Returns the name that isolates the streams of |url|, which is the host
+  // of its site.
+  static std::string GetIsolationUsername(const GURL& url);
+
   // ProxyConfigService methods:
   void AddObserver(Observer* observer) override {}
   void RemoveObserver(Observer* observer) override {}
@@ -70,10 +94,70 @@ class TorProxyConfigService : public net::ProxyConfigService {
 
  private:
   net::ProxyConfig config_;
+  net::ProxyResolutionService* service_;  // NOT OWNED
+  scoped_refptr<TorProxyDelegate> delegate_;
 
   std::string scheme_;
   std::string host_;
   std::string port_;
+
+  DISALLOW_COPY_AND_ASSIGN(TorProxyConfigService);
+};
+
+// ProxyDelegate that adds the stream isolation credentials of the requested
+// site to the Tor proxy. Each Tor profile has its own delegate, so a new Tor
+// profile never reuses the credentials, and circuits, of an earlier one.
+// ProxyResolutionService doesn't own its delegate, so every
+// TorProxyConfigService holds a reference to it and it outlives the services
+// it is installed on. It can be created on any thread but is otherwise only
+// used, and deleted, on the IO thread.
+class TorProxyDelegate
+    : public net::ProxyDelegate,
+      public base::RefCountedThreadSafe<
+          TorProxyDelegate,
+          content::BrowserThread::DeleteOnIOThread> {
+ public:
+  TorProxyDelegate();
+
+  TorProxyConfigService::TorProxyMap* tor_proxy_map() {
+    return &tor_proxy_map_;
+  }
+
+  // Whether this is the delegate of |service|, which is the case while
+  // |service| uses a TorProxyConfigService created for this delegate.
+  bool IsInstalledOn(net::ProxyResolutionService* service) const;
+
+  // ProxyDelegate methods:
+  void OnResolveProxy(const GURL& url,
+                      const std::string& method,
+                      const net::ProxyRetryInfoMap& proxy_retry_info,
+                      net::ProxyInfo* result) override;
+  void OnFallback(const net::ProxyServer& bad_proxy, int net_error) override {}
+  void OnBeforeTunnelRequest(const net::ProxyServer& proxy_server,
+                             net::HttpRequestHeaders* extra_headers) override {}
+  net::Error OnTunnelHeadersReceived(
+      const net::ProxyServer& proxy_server,
+      const net::HttpResponseHeaders& response_headers) override;
+
+ private:
+  friend class base::RefCountedThreadSafe<
+      TorProxyDelegate, content::BrowserThread::DeleteOnIOThread>;
+  friend class base::DeleteHelper<TorProxyDelegate>;
+  friend struct content::BrowserThread::DeleteOnThread<
+      content::BrowserThread::IO>;
+  friend class TorProxyConfigService;
+
+  ~TorProxyDelegate() override;
+
+  void AddConfigService(net::ProxyResolutionService* service);
+  void RemoveConfigService(net::ProxyResolutionService* service);
+
+  TorProxyConfigService::TorProxyMap tor_proxy_map_;
+  // The number of TorProxyConfigServices alive per service. There are two
+  // while a service replaces its config.
+  std::map<net::ProxyResolutionService*, int> config_services_;
+
+  DISALLOW_COPY_AND_ASSIGN(TorProxyDelegate);
 };
 
 }  // namespace tor
@@ -0,0 +1,157 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/tor/tor_proxy_config_service.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind_helpers.h"
+#include "brave/common/tor/tor_test_constants.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "net/base/proxy_server.h"
+#include "net/log/net_log_with_source.h"
+#include "net/proxy_resolution/proxy_info.h"
+#include "net/proxy_resolution/proxy_resolution_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using tor::TorProxyConfigService;
+using tor::TorProxyDelegate;
+
+class TorProxyConfigServiceTest : public testing::Test {
+ public:
+  TorProxyConfigServiceTest()
+      : thread_bundle_(content::TestBrowserThreadBundle::IO_MAINLOOP),
+        delegate_(base::MakeRefCounted<TorProxyDelegate>()) {}
+  ~TorProxyConfigServiceTest() override {}
+
+ protected:
+  net::HostPortPair ResolveProxy(TorProxyDelegate* delegate,
+                                 const std::string& url) {
+    net::ProxyInfo info;
+    info.UseNamedProxy(tor::kTestTorProxy);
+    delegate->OnResolveProxy(GURL(url), "GET", net::ProxyRetryInfoMap(),
+                             &info);
+    return info.proxy_server().host_port_pair();
+  }
+
+  net::HostPortPair ResolveProxy(const std::string& url) {
+    return ResolveProxy(delegate_.get(), url);
+  }
+
+  // Declared first so that |delegate_| is deleted on a live IO thread.
+  content::TestBrowserThreadBundle thread_bundle_;
+  scoped_refptr<TorProxyDelegate> delegate_;
+};
+
+TEST_F(TorProxyConfigServiceTest, IsolatesStreamsBySite) {
+  net::HostPortPair first = ResolveProxy("https://www.example.com/a");
+  EXPECT_EQ("example.com", first.username());
+  EXPECT_FALSE(first.password().empty());
+  EXPECT_EQ("127.0.0.1", first.host());
+  EXPECT_EQ(9999, first.port());
+
+  // Hosts of the same site share credentials.
+  net::HostPortPair same_site = ResolveProxy("https://cdn.example.com/b");
+  EXPECT_EQ(first.username(), same_site.username());
+  EXPECT_EQ(first.password(), same_site.password());
+
+  net::HostPortPair other_site = ResolveProxy("https://brave.com/");
+  EXPECT_EQ("brave.com", other_site.username());
+  EXPECT_NE(first.password(), other_site.password());
+}
+
+TEST_F(TorProxyConfigServiceTest, NewCircuitChangesPassword) {
+  net::HostPortPair before = ResolveProxy("https://example.com/");
+  delegate_->tor_proxy_map()->Erase("example.com");
+  net::HostPortPair after = ResolveProxy("https://example.com/");
+  EXPECT_NE(before.password(), after.password());
+}
+
+TEST_F(TorProxyConfigServiceTest, NewProfileGetsFreshCredentials) {
+  net::HostPortPair old_profile = ResolveProxy("https://example.com/");
+
+  // Every Tor profile has its own delegate, so reopening a Tor window
+  // doesn't reuse the circuits of the one that was closed.
+  delegate_ = base::MakeRefCounted<TorProxyDelegate>();
+  net::HostPortPair new_profile = ResolveProxy("https://example.com/");
+  EXPECT_EQ(old_profile.username(), new_profile.username());
+  EXPECT_NE(old_profile.password(), new_profile.password());
+}
+
+TEST_F(TorProxyConfigServiceTest, ServiceKeepsDelegateAlive) {
+  std::unique_ptr<net::ProxyResolutionService> service =
+      net::ProxyResolutionService::CreateDirect();
+  TorProxyDelegate* delegate = delegate_.get();
+  TorProxyConfigService::TorSetProxy(service.get(), tor::kTestTorProxy,
+                                     "example.com", delegate, false);
+
+  // The profile goes away before the URLRequestContext that uses its
+  // delegate.
+  delegate_ = nullptr;
+  EXPECT_TRUE(delegate->IsInstalledOn(service.get()));
+  net::ProxyInfo info;
+  std::unique_ptr<net::ProxyResolutionService::Request> request;
+  service->ResolveProxy(GURL("https://www.example.com/"), "GET", &info,
+                        base::DoNothing(), &request,
+                        net::NetLogWithSource());
+  EXPECT_EQ("example.com", info.proxy_server().host_port_pair().username());
+  service.reset();
+}
+
+TEST_F(TorProxyConfigServiceTest, InstallsConfigOnce) {
+  std::unique_ptr<net::ProxyResolutionService> service =
+      net::ProxyResolutionService::CreateDirect();
+  TorProxyConfigService::TorSetProxy(service.get(), tor::kTestTorProxy,
+                                     "example.com", delegate_.get(), false);
+  ASSERT_TRUE(service->config());
+  net::ProxyConfig::ProxyRules rules;
+  rules.ParseFromString(tor::kTestTorProxy);
+  EXPECT_TRUE(service->config()->value().proxy_rules().Equals(rules));
+
+  // Requests to other sites keep the same config, without credentials.
+  TorProxyConfigService::TorSetProxy(service.get(), tor::kTestTorProxy,
+                                     "brave.com", delegate_.get(), false);
+  EXPECT_TRUE(service->config()->value().proxy_rules().Equals(rules));
+}
+
+TEST_F(TorProxyConfigServiceTest, DelegateOutlivesReplacedConfig) {
+  std::unique_ptr<net::ProxyResolutionService> service =
+      net::ProxyResolutionService::CreateDirect();
+  TorProxyConfigService::TorSetProxy(service.get(), tor::kTestTorProxy,
+                                     "example.com", delegate_.get(), false);
+  EXPECT_TRUE(delegate_->IsInstalledOn(service.get()));
+
+  // A new Tor proxy replaces the config service but keeps the delegate, and
+  // installing it again would trip the check in SetProxyDelegate().
+  const std::string other_proxy = "socks5://127.0.0.1:9998";
+  TorProxyConfigService::TorSetProxy(service.get(), other_proxy,
+                                     "example.com", delegate_.get(), false);
+  EXPECT_TRUE(delegate_->IsInstalledOn(service.get()));
+  net::ProxyConfig::ProxyRules rules;
+  rules.ParseFromString(other_proxy);
+  EXPECT_TRUE(service->config()->value().proxy_rules().Equals(rules));
+
+  net::ProxyInfo info;
+  std::unique_ptr<net::ProxyResolutionService::Request> request;
+  service->ResolveProxy(GURL("https://www.example.com/"), "GET", &info,
+                        base::DoNothing(), &request,
+                        net::NetLogWithSource());
+  EXPECT_EQ("example.com", info.proxy_server().host_port_pair().username());
+
+  net::ProxyResolutionService* destroyed_service = service.get();
+  service.reset();
+  EXPECT_FALSE(delegate_->IsInstalledOn(destroyed_service));
+}
+
+TEST_F(TorProxyConfigServiceTest, NoDelegate) {
+  std::unique_ptr<net::ProxyResolutionService> service =
+      net::ProxyResolutionService::CreateDirect();
+  TorProxyConfigService::TorSetProxy(service.get(), tor::kTestTorProxy,
+                                     "example.com", nullptr, false);
+  ASSERT_TRUE(service->config());
+  EXPECT_FALSE(delegate_->IsInstalledOn(service.get()));
+}
@@ -9,100 +9,113 @@
 #include <map>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/common/url_rule_table.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 namespace brave {
 
+namespace {
+
+enum ShieldExceptionRule {
+  kUAWhitelistedRule,
+  kBlockedResourceRule,
+  kRedditFirstPartyRule,
+  kRedditEmbedRule,
+  kFacebookCDNRule,
+  kGoogleContentAPIRule,
+  kWhitelistedReferrerRule,
+};
+
+URLRuleTable* CreateShieldExceptionRules() {
+  URLRuleTable* table = new URLRuleTable();
+  table->AddRule(kUAWhitelistedRule, URLPattern::SCHEME_ALL,
+                 "https://*.adobe.com/*");
+  table->AddRule(kUAWhitelistedRule, URLPattern::SCHEME_ALL,
+                 "https://*.duckduckgo.com/*");
+  table->AddRule(kUAWhitelistedRule, URLPattern::SCHEME_ALL,
+                 "https://*.brave.com/*");
+  // For Widevine
+  table->AddRule(kUAWhitelistedRule, URLPattern::SCHEME_ALL,
+                 "https://*.netflix.com/*");
+
+  table->AddRule(kBlockedResourceRule, URLPattern::SCHEME_ALL,
+                 "https://pdfjs.robwu.nl/*");
+
+  // https://github.com/brave/browser-laptop/issues/5861
+  // The below patterns are done to only allow the specific request
+  // pattern, of reddit -> redditmedia -> embedly -> imgur.
+  table->AddRule(kRedditFirstPartyRule, URLPattern::SCHEME_HTTPS,
+                 "https://www.reddit.com/*");
+  table->AddRule(kRedditEmbedRule, URLPattern::SCHEME_HTTPS,
+                 "https://www.reddit.com/*");
+  table->AddRule(kRedditEmbedRule, URLPattern::SCHEME_HTTPS,
+                 "https://www.redditmedia.com/*");
+  table->AddRule(kRedditEmbedRule, URLPattern::SCHEME_HTTPS,
+                 "https://cdn.embedly.com/*");
+  table->AddRule(kRedditEmbedRule, URLPattern::SCHEME_HTTPS,
+                 "https://imgur.com/*");
+
+  table->AddRule(kFacebookCDNRule, URLPattern::SCHEME_HTTPS,
+                 "https://*.fbcdn.net/*");
+  table->AddRule(kGoogleContentAPIRule, URLPattern::SCHEME_HTTPS,
+                 "https://content.googleapis.com/*");
+
+  // It's preferred to use first party specific rules when possible.
+  table->AddRule(kWhitelistedReferrerRule, URLPattern::SCHEME_ALL,
+                 "https://use.typekit.net/*");
+  table->AddRule(kWhitelistedReferrerRule, URLPattern::SCHEME_ALL,
+                 "https://api.geetest.com/*");
+  table->AddRule(kWhitelistedReferrerRule, URLPattern::SCHEME_ALL,
+                 "https://cloud.typography.com/*");
+  return table;
+}
+
+const URLRuleTable& GetShieldExceptionRules() {
+  // Leaked so that lookups from the IO thread never race with destruction.
+  static const URLRuleTable* rules = CreateShieldExceptionRules();
+  return *rules;
+}
+
+bool MatchesShieldExceptionRule(const GURL& url, ShieldExceptionRule rule) {
+  return GetShieldExceptionRules().Match(url) &
+         URLRuleTable::MaskForRule(rule);
+}
+
+}  // namespace
+
 bool IsUAWhitelisted(const GURL& gurl) {
-  static std::vector<URLPattern> whitelist_patterns({
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
-    // For Widevine
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")
-  });
-  return std::any_of(whitelist_patterns.begin(), whitelist_patterns.end(),
-      [&gurl](URLPattern pattern){
-        return pattern.MatchesURL(gurl);
-      });
+  return MatchesShieldExceptionRule(gurl, kUAWhitelistedRule);
 }
 
 bool IsBlockedResource(const GURL& gurl) {
-  static std::vector<URLPattern> blocked_patterns({
-      URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*")
-  });
-  return std::any_of(blocked_patterns.begin(), blocked_patterns.end(),
-                     [&gurl](URLPattern pattern){
-                       return pattern.MatchesURL(gurl);
-                     });
+  return MatchesShieldExceptionRule(gurl, kBlockedResourceRule);
 }
 
 bool IsWhitelistedReferrer(const GURL& firstPartyOrigin,
     const GURL& subresourceUrl) {
   // Note that there's already an exception for TLD+1, so don't add those here.
   // Check with the security team before adding exceptions.
+  const URLRuleTable::RuleMask subresource_rules =
+      GetShieldExceptionRules().Match(subresourceUrl);
+  if (subresource_rules & URLRuleTable::MaskForRule(kWhitelistedReferrerRule))
+    return true;
 
-  // https://github.com/brave/browser-laptop/issues/5861
-  // The below patterns are done to only allow the specific request
-  // pattern, of reddit -> redditmedia -> embedly -> imgur.
-  static auto redditPtrn = URLPattern(URLPattern::SCHEME_HTTPS,
-      "https://www.reddit.com/*");
-  static std::vector<URLPattern> reddit_embed_patterns({
-    redditPtrn,
-    URLPattern(URLPattern::SCHEME_HTTPS, "https://www.redditmedia.com/*"),
-    URLPattern(URLPattern::SCHEME_HTTPS, "https://cdn.embedly.com/*"),
-    URLPattern(URLPattern::SCHEME_HTTPS, "https://imgur.com/*")
-  });
-
-  if (redditPtrn.MatchesURL(firstPartyOrigin)) {
-    bool is_reddit_embed = std::any_of(
-      reddit_embed_patterns.begin(),
-      reddit_embed_patterns.end(),
-      [&subresourceUrl](URLPattern pattern){
-        return pattern.MatchesURL(subresourceUrl);
-      });
-    if (is_reddit_embed) {
-      return true;
-    }
-  }
-
-  static std::map<GURL, std::vector<URLPattern> > whitelist_patterns_map = {
-    {
-      GURL("https://www.facebook.com/"), {
-        URLPattern(URLPattern::SCHEME_HTTPS, "https://*.fbcdn.net/*"),
-      }
-    },
-    {
-      GURL("https://accounts.google.com/"), {
-        URLPattern(URLPattern::SCHEME_HTTPS,
-            "https://content.googleapis.com/*"),
-      }
-    },
-  };
-  std::map<GURL, std::vector<URLPattern> >::iterator i =
-      whitelist_patterns_map.find(firstPartyOrigin);
-  if (i != whitelist_patterns_map.end()) {
-    std::vector<URLPattern> &exceptions = i->second;
-    bool any_match = std::any_of(exceptions.begin(), exceptions.end(),
-        [&subresourceUrl](const URLPattern& pattern) {
-          return pattern.MatchesURL(subresourceUrl);
-        });
-    if (any_match) {
-      return true;
-    }
+  if ((subresource_rules & URLRuleTable::MaskForRule(kRedditEmbedRule)) &&
+      MatchesShieldExceptionRule(firstPartyOrigin, kRedditFirstPartyRule)) {
+    return true;
   }
 
-  // It's preferred to use specific_patterns below when possible
-  static std::vector<URLPattern> whitelist_patterns({
-    URLPattern(URLPattern::SCHEME_ALL, "https://use.typekit.net/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://api.geetest.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://cloud.typography.com/*")
-  });
-  return std::any_of(whitelist_patterns.begin(), whitelist_patterns.end(),
-    [&subresourceUrl](URLPattern pattern){
-      return pattern.MatchesURL(subresourceUrl);
-    });
+  // The subresource rules allowed on exactly one first party origin.
+  static base::NoDestructor<std::map<GURL, ShieldExceptionRule>>
+      first_party_rules(std::map<GURL, ShieldExceptionRule>({
+          {GURL("https://www.facebook.com/"), kFacebookCDNRule},
+          {GURL("https://accounts.google.com/"), kGoogleContentAPIRule},
+      }));
+  auto i = first_party_rules->find(firstPartyOrigin);
+  return i != first_party_rules->end() &&
+         (subresource_rules & URLRuleTable::MaskForRule(i->second));
 }
 
 bool IsWhitelistedCookieException(const GURL& firstPartyOrigin,
@@ -0,0 +1,88 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_rule_table.h"
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+URLRuleTable::Rule::Rule(int id, bool host_only, const URLPattern& pattern)
+    : id(id), host_only(host_only), pattern(pattern) {
+}
+
+URLRuleTable::Rule::Rule(const Rule& other) = default;
+
+URLRuleTable::Rule::~Rule() = default;
+
+URLRuleTable::URLRuleTable() = default;
+
+URLRuleTable::~URLRuleTable() = default;
+
+void URLRuleTable::AddRule(int id, int valid_schemes,
+                           const std::string& pattern) {
+  AddRuleInternal(id, false, valid_schemes, pattern);
+}
+
+void URLRuleTable::AddHostRule(int id, int valid_schemes,
+                               const std::string& pattern) {
+  AddRuleInternal(id, true, valid_schemes, pattern);
+}
+
+void URLRuleTable::AddRuleInternal(int id, bool host_only, int valid_schemes,
+                                   const std::string& pattern) {
+  DCHECK_GE(id, 0);
+  DCHECK_LE(id, kMaxRuleId);
+  URLPattern url_pattern(valid_schemes, pattern);
+  Rule rule(id, host_only, url_pattern);
+  if (url_pattern.host().empty()) {
+    any_host_rules_.push_back(rule);
+  } else {
+    rules_by_host_[url_pattern.host()].push_back(rule);
+  }
+  size_++;
+}
+
+URLRuleTable::RuleMask URLRuleTable::Match(const GURL& url) const {
+  RuleMask matches = MatchRules(any_host_rules_, url);
+  if (rules_by_host_.empty() || !url.has_host()) {
+    return matches;
+  }
+  // Rules for a parent domain are candidates too; URLPattern decides whether
+  // they allow subdomains.
+  base::StringPiece host = url.host_piece();
+  while (!host.empty()) {
+    auto it = rules_by_host_.find(host.as_string());
+    if (it != rules_by_host_.end()) {
+      matches |= MatchRules(it->second, url);
+    }
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos) {
+      break;
+    }
+    host.remove_prefix(dot + 1);
+  }
+  return matches;
+}
+
+// static
+URLRuleTable::RuleMask URLRuleTable::MatchRules(const std::vector<Rule>& rules,
+                                                const GURL& url) {
+  RuleMask matches = 0;
+  for (const Rule& rule : rules) {
+    if (matches & MaskForRule(rule.id)) {
+      continue;
+    }
+    if (rule.host_only ? rule.pattern.MatchesHost(url)
+                       : rule.pattern.MatchesURL(url)) {
+      matches |= MaskForRule(rule.id);
+    }
+  }
+  return matches;
+}
+
+}  // namespace brave
@@ -0,0 +1,74 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMMON_URL_RULE_TABLE_H_
+#define BRAVE_COMMON_URL_RULE_TABLE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// A fixed list of URLPatterns compiled into a table keyed by host. Finding
+// the rules that match a URL costs one hash lookup per label of its host,
+// plus a URLPattern check for each candidate, instead of a scan over every
+// pattern. Each rule has a small integer id, and a lookup reports all the
+// matching rules at once as a bit mask so callers can dispatch on it.
+class URLRuleTable {
+ public:
+  using RuleMask = uint64_t;
+
+  static const int kMaxRuleId = 63;
+
+  static RuleMask MaskForRule(int id) { return RuleMask(1) << id; }
+
+  URLRuleTable();
+  ~URLRuleTable();
+
+  // Adds a rule matching URLs against |pattern|. Several patterns may share
+  // an id.
+  void AddRule(int id, int valid_schemes, const std::string& pattern);
+  // Like AddRule, but only the host of |pattern| is compared.
+  void AddHostRule(int id, int valid_schemes, const std::string& pattern);
+
+  RuleMask Match(const GURL& url) const;
+
+  size_t size() const { return size_; }
+
+ private:
+  struct Rule {
+    Rule(int id, bool host_only, const URLPattern& pattern);
+    Rule(const Rule& other);
+    ~Rule();
+
+    int id;
+    bool host_only;
+    URLPattern pattern;
+  };
+
+  void AddRuleInternal(int id, bool host_only, int valid_schemes,
+                       const std::string& pattern);
+  static RuleMask MatchRules(const std::vector<Rule>& rules, const GURL& url);
+
+  // Rules keyed by the host of their pattern, without any "*." prefix.
+  std::unordered_map<std::string, std::vector<Rule>> rules_by_host_;
+  // Rules whose pattern matches every host.
+  std::vector<Rule> any_host_rules_;
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRuleTable);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMMON_URL_RULE_TABLE_H_
@@ -0,0 +1,75 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_rule_table.h"
+
+#include <string>
+
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave::URLRuleTable;
+
+namespace {
+
+enum TestRule {
+  kExactRule,
+  kSubdomainRule,
+  kAnyHostRule,
+  kHostOnlyRule,
+};
+
+bool Matches(const URLRuleTable& table, const std::string& url,
+             TestRule rule) {
+  return table.Match(GURL(url)) & URLRuleTable::MaskForRule(rule);
+}
+
+}  // namespace
+
+TEST(URLRuleTableTest, MatchesByHost) {
+  URLRuleTable table;
+  table.AddRule(kExactRule, URLPattern::SCHEME_HTTPS,
+                "https://www.forbes.com/*");
+  table.AddRule(kSubdomainRule, URLPattern::SCHEME_ALL,
+                "https://*.fbcdn.net/*");
+  EXPECT_EQ(2u, table.size());
+
+  EXPECT_TRUE(Matches(table, "https://www.forbes.com/a", kExactRule));
+  EXPECT_FALSE(Matches(table, "http://www.forbes.com/a", kExactRule));
+  EXPECT_FALSE(Matches(table, "https://forbes.com/a", kExactRule));
+  EXPECT_FALSE(Matches(table, "https://a.www.forbes.com/a", kExactRule));
+
+  EXPECT_TRUE(Matches(table, "https://fbcdn.net/", kSubdomainRule));
+  EXPECT_TRUE(Matches(table, "https://video.xx.fbcdn.net/", kSubdomainRule));
+  EXPECT_FALSE(Matches(table, "https://notfbcdn.net/", kSubdomainRule));
+  EXPECT_EQ(0u, table.Match(GURL("https://example.com/")));
+}
+
+TEST(URLRuleTableTest, ReportsAllMatchingRules) {
+  URLRuleTable table;
+  table.AddRule(kExactRule, URLPattern::SCHEME_ALL,
+                "https://mobile.twitter.com/i/*");
+  table.AddRule(kSubdomainRule, URLPattern::SCHEME_ALL,
+                "https://*.twitter.com/*");
+  table.AddRule(kAnyHostRule, URLPattern::SCHEME_ALL, "*://*/*crl-set*");
+
+  EXPECT_EQ(URLRuleTable::MaskForRule(kExactRule) |
+                URLRuleTable::MaskForRule(kSubdomainRule),
+            table.Match(GURL("https://mobile.twitter.com/i/nojs_router")));
+  EXPECT_EQ(URLRuleTable::MaskForRule(kSubdomainRule),
+            table.Match(GURL("https://mobile.twitter.com/home")));
+  EXPECT_EQ(URLRuleTable::MaskForRule(kAnyHostRule),
+            table.Match(GURL("http://dl.google.com/crl-set-123")));
+}
+
+TEST(URLRuleTableTest, HostOnlyRulesIgnorePath) {
+  URLRuleTable table;
+  table.AddHostRule(kHostOnlyRule, URLPattern::SCHEME_HTTPS,
+                    "https://safebrowsing.googleapis.com/");
+  EXPECT_TRUE(Matches(table, "https://safebrowsing.googleapis.com/v4/x",
+                      kHostOnlyRule));
+  EXPECT_FALSE(Matches(table, "https://googleapis.com/v4/x", kHostOnlyRule));
+}
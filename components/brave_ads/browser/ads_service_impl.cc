@@ -241,6 +241,11 @@ bool ResetOnFileTaskRunner(
   return base::DeleteFile(path, false);
 }
 
+void VacuumBundleStateOnFileTaskRunner(BundleStateDatabase* backend) {
+  if (backend && backend->needs_vacuum())
+    backend->Vacuum();
+}
+
 bool SaveBundleStateOnFileTaskRunner(
     std::unique_ptr<ads::BundleState> bundle_state,
     BundleStateDatabase* backend) {
@@ -418,10 +423,12 @@ void AdsServiceImpl::ProcessIdleState(ui::IdleState idle_state) {
   if (!connected() || idle_state == last_idle_state_)
     return;
 
-  if (idle_state == ui::IdleState::IDLE_STATE_ACTIVE)
+  if (idle_state == ui::IdleState::IDLE_STATE_ACTIVE) {
     bat_ads_->OnUnIdle();
-  else
+  } else {
     bat_ads_->OnIdle();
+    VacuumBundleState();
+  }
 
   last_idle_state_ = idle_state;
 }
@@ -939,6 +946,14 @@ void AdsServiceImpl::OnBackground() {
   if (connected()) {
     bat_ads_->OnBackground();
   }
+
+  VacuumBundleState();
+}
+
+void AdsServiceImpl::VacuumBundleState() {
+  file_task_runner_->PostTask(FROM_HERE,
+      base::BindOnce(&VacuumBundleStateOnFileTaskRunner,
+                     bundle_state_backend_.get()));
 }
 
 void AdsServiceImpl::OnForeground() {
@@ -165,6 +165,7 @@ class AdsServiceImpl : public AdsService,
                            const std::string& category,
                            const std::vector<ads::AdInfo>& ads);
   void OnSaveBundleState(const ads::OnSaveCallback& callback, bool success);
+  void VacuumBundleState();
   void OnLoaded(const ads::OnLoadCallback& callback,
                 const std::string& value);
   void OnSaved(const ads::OnSaveCallback& callback, bool success);
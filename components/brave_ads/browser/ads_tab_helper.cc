@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/strings/string_util.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "chrome/browser/dom_distiller/dom_distiller_service_factory.h"
@@ -30,6 +31,14 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Only the leading visible text of a page is sent for classification so that
+// heavy pages do not inflate the IPC payload or the classifier's work
+const size_t kMaximumPageTextLength = 32 * 1024;
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(SessionTabHelper::IdForTab(web_contents)),
@@ -94,7 +103,7 @@ void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
           std::move(source_page_handle));
 
   auto options = dom_distiller::proto::DomDistillerOptions();
-  // options.set_extract_text_only(true);
+  options.set_extract_text_only(true);
   // options.set_debug_level(1);
 
   auto* distiller_page_ptr = distiller_page.get();
@@ -120,8 +129,11 @@ void AdsTabHelper::OnWebContentsDistillationDone(
       distiller_result->has_distilled_content() &&
       distiller_result->has_markup_info() &&
       distiller_result->distilled_content().has_html()) {
-    ads_service_->ClassifyPage(url.spec(),
-                               distiller_result->distilled_content().html());
+    // with |extract_text_only| set the distilled content is plain text
+    std::string text;
+    base::TruncateUTF8ToByteSize(distiller_result->distilled_content().html(),
+                                 kMaximumPageTextLength, &text);
+    ads_service_->ClassifyPage(url.spec(), text);
   } else {
     // TODO(bridiver) - fall back to web_contents()->GenerateMHTML or ignore?
   }
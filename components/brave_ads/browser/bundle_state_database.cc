@@ -8,7 +8,9 @@
 #include <stdint.h>
 
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
@@ -29,7 +31,8 @@ const int kCompatibleVersionNumber = 2;
 
 BundleStateDatabase::BundleStateDatabase(const base::FilePath& db_path) :
     db_path_(db_path),
-    initialized_(false) {
+    initialized_(false),
+    needs_vacuum_(false) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -90,21 +93,6 @@ bool BundleStateDatabase::CreateCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM category"));
-  return sql.Run();
-}
-
-
 bool BundleStateDatabase::CreateAdInfoTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -134,20 +122,6 @@ bool BundleStateDatabase::CreateAdInfoTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM ad_info"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -174,20 +148,6 @@ bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "DELETE FROM ad_info_category"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -209,41 +169,184 @@ bool BundleStateDatabase::SaveBundleState(
   if (!GetDB().BeginTransaction())
     return false;
 
-  // we are completely replacing here so first truncate all the tables
-  if (!TruncateAdInfoCategoryTable() ||
-      !TruncateAdInfoTable() ||
-      !TruncateCategoryTable()) {
+  // Only write what differs from the stored bundle, so that a catalog refresh
+  // costs as much as it changes. Whatever is left in the stale sets once the
+  // new bundle has been walked is no longer part of it
+  std::set<std::string> stale_categories;
+  std::set<AdInfoKey> stale_ad_infos;
+  std::set<AdInfoCategoryKey> stale_ad_info_categories;
+  if (!GetCategories(&stale_categories) ||
+      !GetAdInfoKeys(&stale_ad_infos) ||
+      !GetAdInfoCategoryKeys(&stale_ad_info_categories)) {
     GetDB().RollbackTransaction();
     return false;
   }
 
-  auto categories = bundle_state.categories;
-  for (std::map<std::string, std::vector<ads::AdInfo>>::iterator it =
-      categories.begin();  it != categories.end(); ++it) {
-    auto category = it->first;
-    if (!InsertOrUpdateCategory(category)) {
+  std::set<AdInfoKey> saved_ad_infos;
+  for (const auto& category : bundle_state.categories) {
+    const std::string& name = category.first;
+    if (!stale_categories.erase(name) && !InsertOrUpdateCategory(name)) {
       GetDB().RollbackTransaction();
       return false;
     }
 
-    auto ads = it->second;
-    for (std::vector<ads::AdInfo>::iterator ad_it = ads.begin();
-        ad_it != ads.end(); ++ad_it) {
-      auto ad_info = *ad_it;
-      if (!InsertOrUpdateAdInfo(ad_info) ||
-          !InsertOrUpdateAdInfoCategory(ad_info, category)) {
+    for (const auto& ad_info : category.second) {
+      for (const auto& region : ad_info.regions) {
+        const AdInfoKey key(region, ad_info.uuid);
+        if (!saved_ad_infos.insert(key).second)
+          continue;
+
+        if (stale_ad_infos.erase(key) && IsAdInfoUnchanged(ad_info, region))
+          continue;
+
+        if (!InsertOrUpdateAdInfo(ad_info, region)) {
+          GetDB().RollbackTransaction();
+          return false;
+        }
+      }
+
+      const AdInfoCategoryKey category_key(ad_info.uuid, name);
+      if (!stale_ad_info_categories.erase(category_key) &&
+          !InsertOrUpdateAdInfoCategory(ad_info, name)) {
         GetDB().RollbackTransaction();
         return false;
       }
     }
   }
 
-  if (GetDB().CommitTransaction()) {
-    Vacuum();
-    return true;
+  for (const auto& key : stale_ad_info_categories) {
+    if (!DeleteAdInfoCategory(key)) {
+      GetDB().RollbackTransaction();
+      return false;
+    }
   }
 
-  return false;
+  for (const auto& key : stale_ad_infos) {
+    if (!DeleteAdInfo(key)) {
+      GetDB().RollbackTransaction();
+      return false;
+    }
+  }
+
+  for (const auto& name : stale_categories) {
+    if (!DeleteCategory(name)) {
+      GetDB().RollbackTransaction();
+      return false;
+    }
+  }
+
+  if (!GetDB().CommitTransaction())
+    return false;
+
+  if (!stale_ad_info_categories.empty() ||
+      !stale_ad_infos.empty() ||
+      !stale_categories.empty()) {
+    needs_vacuum_ = true;
+  }
+
+  return true;
+}
+
+bool BundleStateDatabase::GetCategories(std::set<std::string>* categories) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(
+      GetDB().GetCachedStatement(SQL_FROM_HERE, "SELECT name FROM category"));
+
+  while (sql.Step())
+    categories->insert(sql.ColumnString(0));
+
+  return sql.Succeeded();
+}
+
+bool BundleStateDatabase::GetAdInfoKeys(std::set<AdInfoKey>* keys) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT region, uuid FROM ad_info"));
+
+  while (sql.Step())
+    keys->emplace(sql.ColumnString(0), sql.ColumnString(1));
+
+  return sql.Succeeded();
+}
+
+bool BundleStateDatabase::GetAdInfoCategoryKeys(
+    std::set<AdInfoCategoryKey>* keys) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT ad_info_uuid, category_name FROM ad_info_category"));
+
+  while (sql.Step())
+    keys->emplace(sql.ColumnString(0), sql.ColumnString(1));
+
+  return sql.Succeeded();
+}
+
+bool BundleStateDatabase::IsAdInfoUnchanged(const ads::AdInfo& info,
+                                            const std::string& region) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "SELECT 1 FROM ad_info "
+          "WHERE region = ? AND uuid = ? AND creative_set_id IS ? AND "
+          "advertiser IS ? AND notification_text IS ? AND "
+          "notification_url IS ? AND start_timestamp IS datetime(?) AND "
+          "end_timestamp IS datetime(?) AND campaign_id IS ? AND "
+          "daily_cap = ? AND per_day = ? AND total_max = ?"));
+
+  sql.BindString(0, region);
+  sql.BindString(1, info.uuid);
+  sql.BindString(2, info.creative_set_id);
+  sql.BindString(3, info.advertiser);
+  sql.BindString(4, info.notification_text);
+  sql.BindString(5, info.notification_url);
+  sql.BindString(6, info.start_timestamp);
+  sql.BindString(7, info.end_timestamp);
+  sql.BindString(8, info.campaign_id);
+  sql.BindInt(9, info.daily_cap);
+  sql.BindInt(10, info.per_day);
+  sql.BindInt(11, info.total_max);
+
+  return sql.Step();
+}
+
+bool BundleStateDatabase::DeleteCategory(const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM category WHERE name = ?"));
+
+  sql.BindString(0, category);
+
+  return sql.Run();
+}
+
+bool BundleStateDatabase::DeleteAdInfo(const AdInfoKey& key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info WHERE region = ? AND uuid = ?"));
+
+  sql.BindString(0, key.first);
+  sql.BindString(1, key.second);
+
+  return sql.Run();
+}
+
+bool BundleStateDatabase::DeleteAdInfoCategory(const AdInfoCategoryKey& key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info_category "
+      "WHERE ad_info_uuid = ? AND category_name = ?"));
+
+  sql.BindString(0, key.first);
+  sql.BindString(1, key.second);
+
+  return sql.Run();
 }
 
 bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
@@ -266,7 +369,8 @@ bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
   return ad_info_statement.Run();
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
+bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info,
+                                               const std::string& region) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   bool initialized = Init();
@@ -275,33 +379,28 @@ bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
   if (!initialized)
     return false;
 
-  for (auto it = info.regions.begin(); it != info.regions.end(); ++it) {
-    sql::Statement ad_info_statement(
-        GetDB().GetCachedStatement(SQL_FROM_HERE,
-            "INSERT OR REPLACE INTO ad_info "
-            "(creative_set_id, advertiser, notification_text, "
-            "notification_url, start_timestamp, end_timestamp, uuid, "
-            "campaign_id, daily_cap, per_day, total_max, region) "
-            "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?)"));
-
-    ad_info_statement.BindString(0, info.creative_set_id);
-    ad_info_statement.BindString(1, info.advertiser);
-    ad_info_statement.BindString(2, info.notification_text);
-    ad_info_statement.BindString(3, info.notification_url);
-    ad_info_statement.BindString(4, info.start_timestamp);
-    ad_info_statement.BindString(5, info.end_timestamp);
-    ad_info_statement.BindString(6, info.uuid);
-    ad_info_statement.BindString(7, info.campaign_id);
-    ad_info_statement.BindInt(8, info.daily_cap);
-    ad_info_statement.BindInt(9, info.per_day);
-    ad_info_statement.BindInt(10, info.total_max);
-    ad_info_statement.BindString(11, *it);
-    if (!ad_info_statement.Run()) {
-      return false;
-    }
-  }
+  sql::Statement ad_info_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "INSERT OR REPLACE INTO ad_info "
+          "(creative_set_id, advertiser, notification_text, "
+          "notification_url, start_timestamp, end_timestamp, uuid, "
+          "campaign_id, daily_cap, per_day, total_max, region) "
+          "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?)"));
+
+  ad_info_statement.BindString(0, info.creative_set_id);
+  ad_info_statement.BindString(1, info.advertiser);
+  ad_info_statement.BindString(2, info.notification_text);
+  ad_info_statement.BindString(3, info.notification_url);
+  ad_info_statement.BindString(4, info.start_timestamp);
+  ad_info_statement.BindString(5, info.end_timestamp);
+  ad_info_statement.BindString(6, info.uuid);
+  ad_info_statement.BindString(7, info.campaign_id);
+  ad_info_statement.BindInt(8, info.daily_cap);
+  ad_info_statement.BindInt(9, info.per_day);
+  ad_info_statement.BindInt(10, info.total_max);
+  ad_info_statement.BindString(11, region);
 
-  return true;
+  return ad_info_statement.Run();
 }
 
 bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
@@ -389,6 +488,13 @@ void BundleStateDatabase::Vacuum() {
   DCHECK_EQ(0, db_.transaction_nesting()) <<
       "Can not have a transaction when vacuuming.";
   ignore_result(db_.Execute("VACUUM"));
+  needs_vacuum_ = false;
+}
+
+bool BundleStateDatabase::needs_vacuum() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return needs_vacuum_;
 }
 
 void BundleStateDatabase::OnMemoryPressure(
@@ -6,7 +6,11 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_BUNDLE_DATA_DATABASE_H_
 
 #include <memory>
+#include <set>
 #include <stddef.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "bat/ads/ad_info.h"
 #include "bat/ads/bundle_state.h"
@@ -45,9 +49,15 @@ class BundleStateDatabase {
   // unused space in the file. It can be VERY SLOW.
   void Vacuum();
 
+  // Whether rows were removed since the last Vacuum(). Vacuuming is left to
+  // the caller, ideally while the user is idle.
+  bool needs_vacuum() const;
+
   std::string GetDiagnosticInfo(int extended_error, sql::Statement* statement);
 
  private:
+  friend class BundleStateDatabaseTest;
+
   bool Init();
   void OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
@@ -57,12 +67,23 @@ class BundleStateDatabase {
   bool CreateAdInfoCategoryTable();
   bool CreateAdInfoCategoryNameIndex();
 
-  bool TruncateCategoryTable();
-  bool TruncateAdInfoTable();
-  bool TruncateAdInfoCategoryTable();
+  // (region, uuid)
+  using AdInfoKey = std::pair<std::string, std::string>;
+  // (ad_info_uuid, category_name)
+  using AdInfoCategoryKey = std::pair<std::string, std::string>;
+
+  bool GetCategories(std::set<std::string>* categories);
+  bool GetAdInfoKeys(std::set<AdInfoKey>* keys);
+  bool GetAdInfoCategoryKeys(std::set<AdInfoCategoryKey>* keys);
+  bool IsAdInfoUnchanged(const ads::AdInfo& info, const std::string& region);
+
+  bool DeleteCategory(const std::string& category);
+  bool DeleteAdInfo(const AdInfoKey& key);
+  bool DeleteAdInfoCategory(const AdInfoCategoryKey& key);
 
   bool InsertOrUpdateCategory(const std::string& category);
-  bool InsertOrUpdateAdInfo(const ads::AdInfo& info);
+  bool InsertOrUpdateAdInfo(const ads::AdInfo& info,
+                            const std::string& region);
   bool InsertOrUpdateAdInfoCategory(const ads::AdInfo& ad_info,
                                     const std::string& category);
 
@@ -76,6 +97,7 @@ class BundleStateDatabase {
   sql::MetaTable meta_table_;
   const base::FilePath db_path_;
   bool initialized_;
+  bool needs_vacuum_;
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
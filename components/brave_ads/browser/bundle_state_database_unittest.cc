@@ -0,0 +1,197 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_util.h"
+#include "base/test/scoped_task_environment.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BundleStateDatabaseTest.*
+
+namespace brave_ads {
+
+class BundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  BundleStateDatabaseTest() {
+  }
+
+  ~BundleStateDatabaseTest() override {
+  }
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  std::unique_ptr<BundleStateDatabase> CreateDatabase(
+      const std::string& name) {
+    base::FilePath db_file = temp_dir_.GetPath().AppendASCII(name);
+    sql::Database::Delete(db_file);
+    return std::make_unique<BundleStateDatabase>(db_file);
+  }
+
+  ads::AdInfo CreateAdInfo(const std::string& uuid,
+                           const std::string& creative_set_id) {
+    ads::AdInfo info;
+    info.creative_set_id = creative_set_id;
+    info.campaign_id = "campaign_1";
+    info.start_timestamp = "2019-01-01 00:00";
+    info.end_timestamp = "2099-12-31 23:59";
+    info.daily_cap = 5;
+    info.per_day = 3;
+    info.total_max = 10;
+    info.regions = {"US", "CA"};
+    info.advertiser = "Brave";
+    info.notification_text = "Text";
+    info.notification_url = "https://brave.com";
+    info.uuid = uuid;
+    return info;
+  }
+
+  void CreateBundleState(ads::BundleState* bundle_state) {
+    bundle_state->categories["Technology & Computing"] = {
+        CreateAdInfo("uuid_1", "creative_set_1"),
+        CreateAdInfo("uuid_2", "creative_set_2")};
+    bundle_state->categories["Sports"] = {
+        CreateAdInfo("uuid_2", "creative_set_2"),
+        CreateAdInfo("uuid_3", "creative_set_3")};
+    bundle_state->categories["Travel"] = {
+        CreateAdInfo("uuid_4", "creative_set_4")};
+  }
+
+  // Returns every row of the bundle tables, in a stable order
+  std::vector<std::string> GetRows(BundleStateDatabase* database) {
+    const char* queries[] = {
+        "SELECT * FROM category ORDER BY name",
+        "SELECT * FROM ad_info ORDER BY region, uuid",
+        "SELECT * FROM ad_info_category "
+            "ORDER BY ad_info_uuid, category_name"};
+
+    std::vector<std::string> rows;
+    for (const char* query : queries) {
+      sql::Statement s(database->GetDB().GetUniqueStatement(query));
+      while (s.Step()) {
+        std::vector<std::string> columns;
+        for (int i = 0; i < s.ColumnCount(); i++) {
+          columns.push_back(s.ColumnString(i));
+        }
+
+        rows.push_back(base::JoinString(columns, "|"));
+      }
+    }
+
+    return rows;
+  }
+
+  // Saves |new_bundle_state| over |old_bundle_state| and checks that the
+  // tables are the same as when |new_bundle_state| is written from scratch
+  void ExpectSameAsFullRewrite(const ads::BundleState& old_bundle_state,
+                               const ads::BundleState& new_bundle_state) {
+    auto database = CreateDatabase("diff.db");
+    ASSERT_TRUE(database->SaveBundleState(old_bundle_state));
+    ASSERT_TRUE(database->SaveBundleState(new_bundle_state));
+
+    auto full_rewrite_database = CreateDatabase("full_rewrite.db");
+    ASSERT_TRUE(full_rewrite_database->SaveBundleState(new_bundle_state));
+
+    auto rows = GetRows(database.get());
+    EXPECT_FALSE(rows.empty());
+    EXPECT_EQ(GetRows(full_rewrite_database.get()), rows);
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_Unchanged) {
+  ads::BundleState bundle_state;
+  CreateBundleState(&bundle_state);
+
+  auto database = CreateDatabase("unchanged.db");
+  ASSERT_TRUE(database->SaveBundleState(bundle_state));
+  auto rows = GetRows(database.get());
+
+  ASSERT_TRUE(database->SaveBundleState(bundle_state));
+  EXPECT_EQ(rows, GetRows(database.get()));
+  EXPECT_FALSE(database->needs_vacuum());
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_AddedAd) {
+  ads::BundleState old_bundle_state;
+  CreateBundleState(&old_bundle_state);
+
+  ads::BundleState new_bundle_state(old_bundle_state);
+  new_bundle_state.categories["Travel"].push_back(
+      CreateAdInfo("uuid_5", "creative_set_5"));
+
+  ExpectSameAsFullRewrite(old_bundle_state, new_bundle_state);
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_RemovedAd) {
+  ads::BundleState old_bundle_state;
+  CreateBundleState(&old_bundle_state);
+
+  ads::BundleState new_bundle_state(old_bundle_state);
+  new_bundle_state.categories["Sports"] = {
+      CreateAdInfo("uuid_2", "creative_set_2")};
+
+  ExpectSameAsFullRewrite(old_bundle_state, new_bundle_state);
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_ChangedAd) {
+  ads::BundleState old_bundle_state;
+  CreateBundleState(&old_bundle_state);
+
+  ads::BundleState new_bundle_state(old_bundle_state);
+  for (auto& category : new_bundle_state.categories) {
+    for (auto& info : category.second) {
+      if (info.uuid != "uuid_2")
+        continue;
+
+      info.notification_text = "Changed text";
+      info.end_timestamp = "2099-06-30 12:00";
+      info.per_day = 4;
+      info.regions = {"US"};
+    }
+  }
+
+  ExpectSameAsFullRewrite(old_bundle_state, new_bundle_state);
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_RemovedCategory) {
+  ads::BundleState old_bundle_state;
+  CreateBundleState(&old_bundle_state);
+
+  ads::BundleState new_bundle_state(old_bundle_state);
+  new_bundle_state.categories.erase("Sports");
+
+  ExpectSameAsFullRewrite(old_bundle_state, new_bundle_state);
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_NeedsVacuumAfterRemoval) {
+  ads::BundleState old_bundle_state;
+  CreateBundleState(&old_bundle_state);
+
+  ads::BundleState new_bundle_state(old_bundle_state);
+  new_bundle_state.categories.erase("Travel");
+
+  auto database = CreateDatabase("vacuum.db");
+  ASSERT_TRUE(database->SaveBundleState(old_bundle_state));
+  ASSERT_TRUE(database->SaveBundleState(new_bundle_state));
+  EXPECT_TRUE(database->needs_vacuum());
+
+  database->Vacuum();
+  EXPECT_FALSE(database->needs_vacuum());
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,135 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// static
+const size_t ReferralHeadersMatcher::kNoEntry =
+    std::numeric_limits<size_t>::max();
+
+ReferralHeadersMatcher::Node::Node() = default;
+
+ReferralHeadersMatcher::Node::~Node() = default;
+
+ReferralHeadersMatcher::ReferralHeadersMatcher(
+    const base::ListValue& referral_headers_list) {
+  for (const auto& headers_value : referral_headers_list) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::DictionaryValue* headers_dict = nullptr;
+    const base::Value* headers =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers || !headers->GetAsDictionary(&headers_dict)) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+    size_t entry = headers_.size();
+    headers_.push_back(headers_dict->CreateDeepCopy());
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (domain_value.is_string()) {
+        AddDomain(domain_value.GetString(), entry);
+      }
+    }
+  }
+}
+
+ReferralHeadersMatcher::~ReferralHeadersMatcher() = default;
+
+namespace {
+
+// Hosts are compared without a trailing dot, so "example.com." and
+// "example.com" are the same host.
+base::StringPiece CanonicalizeHost(base::StringPiece host) {
+  if (host.ends_with(".")) {
+    host.remove_suffix(1);
+  }
+  return host;
+}
+
+}  // namespace
+
+void ReferralHeadersMatcher::AddDomain(const std::string& domain,
+                                       size_t entry) {
+  base::StringPiece host(domain);
+  // Every domain already matches its subdomains, so "*.example.com" is the
+  // same as "example.com" and "*" is the same as an empty domain.
+  if (host.starts_with("*.")) {
+    host.remove_prefix(2);
+  } else if (host == "*") {
+    host = base::StringPiece();
+  }
+  host = CanonicalizeHost(host);
+  if (host.empty()) {
+    match_all_entry_ = std::min(match_all_entry_, entry);
+    return;
+  }
+  Node* node = &root_;
+  std::vector<base::StringPiece> labels = base::SplitStringPiece(
+      host, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  for (auto it = labels.rbegin(); it != labels.rend(); ++it) {
+    std::unique_ptr<Node>& child =
+        node->children[base::ToLowerASCII(*it)];
+    if (!child) {
+      child = std::make_unique<Node>();
+    }
+    node = child.get();
+  }
+  // Entries keep their list order, so the earliest one wins.
+  node->entry = std::min(node->entry, entry);
+}
+
+const base::DictionaryValue* ReferralHeadersMatcher::GetMatchingHeaders(
+    const GURL& url) const {
+  if (!url.SchemeIsHTTPOrHTTPS()) {
+    return nullptr;
+  }
+
+  size_t best = match_all_entry_;
+  // Subdomains of an IP address don't exist, so only the full host counts.
+  const bool is_ip_address = url.HostIsIPAddress();
+  base::StringPiece host = CanonicalizeHost(url.host_piece());
+  const Node* node = &root_;
+  size_t end = host.size();
+  while (end > 0) {
+    size_t dot = host.rfind('.', end - 1);
+    size_t start = dot == base::StringPiece::npos ? 0 : dot + 1;
+    auto child = node->children.find(host.substr(start, end - start));
+    if (child == node->children.end()) {
+      break;
+    }
+    node = child->second.get();
+    const bool is_full_host = start == 0;
+    if (!is_ip_address || is_full_host) {
+      best = std::min(best, node->entry);
+    }
+    if (is_full_host) {
+      break;
+    }
+    end = dot;
+  }
+
+  if (best == kNoEntry) {
+    return nullptr;
+  }
+  return headers_[best].get();
+}
+
+}  // namespace brave
@@ -0,0 +1,64 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/values.h"
+
+class GURL;
+
+namespace brave {
+
+// A compiled form of the referral headers list. Domains are stored in a trie
+// keyed by their labels from the top-level domain down, so finding the
+// headers for a request walks the labels of its host once instead of
+// matching a URLPattern per domain. The matcher is immutable and is rebuilt
+// whenever a new list arrives.
+class ReferralHeadersMatcher {
+ public:
+  explicit ReferralHeadersMatcher(const base::ListValue& referral_headers_list);
+  ~ReferralHeadersMatcher();
+
+  // Returns the headers of the first list entry with a domain that is the
+  // host of |url| or one of its parent domains, or nullptr if none matches.
+  // A domain of "*" or "" matches every host, a leading "*." is ignored and
+  // trailing dots don't affect matching, like the URLPattern host rules.
+  const base::DictionaryValue* GetMatchingHeaders(const GURL& url) const;
+
+  size_t size() const { return headers_.size(); }
+
+ private:
+  struct Node {
+    Node();
+    ~Node();
+
+    base::flat_map<std::string, std::unique_ptr<Node>, std::less<>> children;
+    // The first list entry that names exactly this domain, if any.
+    size_t entry = kNoEntry;
+  };
+
+  static const size_t kNoEntry;
+
+  void AddDomain(const std::string& domain, size_t entry);
+
+  Node root_;
+  // An entry with an empty or "*" domain matches every host.
+  size_t match_all_entry_ = kNoEntry;
+  std::vector<std::unique_ptr<base::DictionaryValue>> headers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferralHeadersMatcher);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
@@ -0,0 +1,204 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave::ReferralHeadersMatcher;
+
+namespace {
+
+const char kTestReferralHeaders[] = R"(
+  [
+    {
+      "domains": [ "marketwatch.com", "barrons.com" ],
+      "headers": { "X-Brave-Partner": "dowjones" }
+    },
+    {
+      "domains": [ "news.marketwatch.com", "popcrush.com" ],
+      "headers": { "X-Brave-Partner": "townsquare" }
+    },
+    {
+      "domains": [ "127.0.0.1" ],
+      "headers": { "X-Brave-Partner": "local" }
+    }
+  ])";
+
+std::unique_ptr<base::ListValue> ReadHeaders(const std::string& json) {
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(json);
+  base::ListValue* list = nullptr;
+  if (!value || !value->GetAsList(&list))
+    return nullptr;
+  return list->CreateDeepCopy();
+}
+
+// A list shaped like the one served in production: a few dozen partners,
+// each with a handful of domains.
+std::unique_ptr<base::ListValue> CreateRealisticHeaders() {
+  auto list = std::make_unique<base::ListValue>();
+  for (int partner = 0; partner < 40; ++partner) {
+    base::DictionaryValue entry;
+    base::ListValue domains;
+    for (int domain = 0; domain < 10; ++domain) {
+      domains.AppendString("partner" + base::NumberToString(partner) +
+                           "-site" + base::NumberToString(domain) + ".com");
+    }
+    entry.SetKey("domains", std::move(domains));
+    base::DictionaryValue headers;
+    headers.SetString("X-Brave-Partner",
+                      "partner" + base::NumberToString(partner));
+    entry.SetKey("headers", std::move(headers));
+    list->GetList().push_back(std::move(entry));
+  }
+  return list;
+}
+
+std::string GetPartner(const base::DictionaryValue* headers) {
+  std::string partner;
+  if (headers)
+    headers->GetString("X-Brave-Partner", &partner);
+  return partner;
+}
+
+}  // namespace
+
+TEST(ReferralHeadersMatcherTest, MatchesHostsAndSubdomains) {
+  std::unique_ptr<base::ListValue> list = ReadHeaders(kTestReferralHeaders);
+  ASSERT_TRUE(list);
+  ReferralHeadersMatcher matcher(*list);
+  EXPECT_EQ(3u, matcher.size());
+
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://marketwatch.com/"))));
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("http://www.barrons.com/a"))));
+  EXPECT_EQ("townsquare", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://popcrush.com/"))));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("https://google.com/")));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("https://notbarrons.com/")));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("ftp://barrons.com/")));
+}
+
+TEST(ReferralHeadersMatcherTest, FirstListEntryWins) {
+  std::unique_ptr<base::ListValue> list = ReadHeaders(kTestReferralHeaders);
+  ASSERT_TRUE(list);
+  ReferralHeadersMatcher matcher(*list);
+  // Both entries match, and the parent domain's entry comes first.
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://news.marketwatch.com/"))));
+}
+
+TEST(ReferralHeadersMatcherTest, IPAddressesOnlyMatchExactly) {
+  std::unique_ptr<base::ListValue> list = ReadHeaders(kTestReferralHeaders);
+  ASSERT_TRUE(list);
+  ReferralHeadersMatcher matcher(*list);
+  EXPECT_EQ("local", GetPartner(
+      matcher.GetMatchingHeaders(GURL("http://127.0.0.1/"))));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("http://10.0.0.1/")));
+}
+
+TEST(ReferralHeadersMatcherTest, WildcardDomains) {
+  std::unique_ptr<base::ListValue> list = ReadHeaders(R"(
+    [
+      {
+        "domains": [ "*.barrons.com" ],
+        "headers": { "X-Brave-Partner": "dowjones" }
+      },
+      {
+        "domains": [ "*" ],
+        "headers": { "X-Brave-Partner": "everyone" }
+      }
+    ])");
+  ASSERT_TRUE(list);
+  ReferralHeadersMatcher matcher(*list);
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://barrons.com/"))));
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://www.barrons.com/"))));
+  EXPECT_EQ("everyone", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://example.com/"))));
+  EXPECT_EQ("everyone", GetPartner(
+      matcher.GetMatchingHeaders(GURL("http://10.0.0.1/"))));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("ftp://example.com/")));
+}
+
+TEST(ReferralHeadersMatcherTest, TrailingDotHosts) {
+  std::unique_ptr<base::ListValue> list = ReadHeaders(R"(
+    [
+      {
+        "domains": [ "marketwatch.com." ],
+        "headers": { "X-Brave-Partner": "dowjones" }
+      },
+      {
+        "domains": [ "popcrush.com" ],
+        "headers": { "X-Brave-Partner": "townsquare" }
+      }
+    ])");
+  ASSERT_TRUE(list);
+  ReferralHeadersMatcher matcher(*list);
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://marketwatch.com/"))));
+  EXPECT_EQ("dowjones", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://www.marketwatch.com./"))));
+  EXPECT_EQ("townsquare", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://popcrush.com./"))));
+  EXPECT_EQ("townsquare", GetPartner(
+      matcher.GetMatchingHeaders(GURL("https://a.b.popcrush.com./path"))));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("https://crush.com./")));
+}
+
+TEST(ReferralHeadersMatcherTest, MatchesRealisticList) {
+  std::unique_ptr<base::ListValue> list = CreateRealisticHeaders();
+  ReferralHeadersMatcher matcher(*list);
+  for (int partner = 0; partner < 45; partner += 3) {
+    for (const char* prefix : {"", "www.", "a.b."}) {
+      GURL url("https://" + std::string(prefix) + "partner" +
+               base::NumberToString(partner) + "-site3.com/path");
+      std::string expected =
+          partner < 40 ? "partner" + base::NumberToString(partner) : "";
+      EXPECT_EQ(expected, GetPartner(matcher.GetMatchingHeaders(url))) << url;
+    }
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests to time building the matcher and
+// matching request URLs against it.
+TEST(ReferralHeadersMatcherTest, DISABLED_Benchmark) {
+  std::unique_ptr<base::ListValue> list = CreateRealisticHeaders();
+  std::vector<GURL> urls;
+  for (int i = 0; i < 1000; ++i) {
+    // Mostly misses, like real browsing, with an occasional partner site.
+    urls.push_back(GURL(i % 50 == 0 ?
+        "https://www.partner" + base::NumberToString(i % 40) + "-site1.com/" :
+        "https://cdn" + base::NumberToString(i) + ".example.org/script.js"));
+  }
+
+  base::ElapsedTimer timer;
+  ReferralHeadersMatcher matcher(*list);
+  base::TimeDelta build_time = timer.Elapsed();
+  int matches = 0;
+  for (const GURL& url : urls) {
+    if (matcher.GetMatchingHeaders(url))
+      matches++;
+  }
+  base::TimeDelta match_time = timer.Elapsed() - build_time;
+
+  EXPECT_EQ(20, matches);
+  LOG(INFO) << "Matched " << urls.size() << " URLs against "
+            << matcher.size() << " entries in "
+            << match_time.InMicroseconds() << "us (built in "
+            << build_time.InMicroseconds() << "us)";
+}
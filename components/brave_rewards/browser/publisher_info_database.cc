@@ -24,9 +24,73 @@ namespace brave_rewards {
 
 namespace {
 
-const int kCurrentVersionNumber = 6;
+const int kCurrentVersionNumber = 7;
 const int kCompatibleVersionNumber = 1;
 
+constexpr base::TimeDelta kFlushPendingWritesDelay =
+    base::TimeDelta::FromSeconds(10);
+
+// Columns GetActivityList() can be ordered by.
+const char* const kActivityListOrderColumns[] = {
+  "ai.publisher_id",
+  "ai.duration",
+  "ai.score",
+  "ai.percent",
+  "ai.weight",
+  "ai.reconcile_stamp",
+  "ai.visits",
+  "pi.verified",
+  "pi.excluded",
+  "pi.name",
+  "pi.url",
+  "pi.provider",
+};
+
+bool IsActivityListOrderColumn(const std::string& column) {
+  for (const char* order_column : kActivityListOrderColumns) {
+    if (column == order_column) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Mirrors the WHERE clause built by GetActivityList() for a single row.
+bool MatchesActivityFilter(const ledger::PublisherInfo& info,
+                           const ledger::ActivityInfoFilter& filter) {
+  if (filter.min_duration > 0 && info.duration < filter.min_duration) {
+    return false;
+  }
+
+  if (filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL &&
+      filter.excluded !=
+        ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED &&
+      static_cast<int>(info.excluded) != static_cast<int>(filter.excluded)) {
+    return false;
+  }
+
+  if (filter.excluded ==
+        ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED &&
+      info.excluded == ledger::PUBLISHER_EXCLUDE::EXCLUDED) {
+    return false;
+  }
+
+  if (filter.percent > 0 && info.percent < filter.percent) {
+    return false;
+  }
+
+  if (filter.min_visits > 0 && info.visits < filter.min_visits) {
+    return false;
+  }
+
+  if (!filter.non_verified && !info.verified) {
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace
 
 PublisherInfoDatabase::PublisherInfoDatabase(const base::FilePath& db_path) :
@@ -37,6 +101,9 @@ PublisherInfoDatabase::PublisherInfoDatabase(const base::FilePath& db_path) :
 }
 
 PublisherInfoDatabase::~PublisherInfoDatabase() {
+  if (initialized_) {
+    ignore_result(FlushPendingWrites());
+  }
 }
 
 bool PublisherInfoDatabase::Init() {
@@ -70,6 +137,7 @@ bool PublisherInfoDatabase::Init() {
   }
 
   CreateContributionInfoIndex();
+  CreatePublisherInfoIndex();
   CreateActivityInfoIndex();
   CreateRecurringDonationIndex();
   CreatePendingContributionsIndex();
@@ -172,6 +240,8 @@ void PublisherInfoDatabase::GetTips(ledger::PublisherInfoList* list,
     return;
   }
 
+  FlushPendingWrites();
+
   sql::Statement info_sql(db_.GetUniqueStatement(
       "SELECT pi.publisher_id, pi.name, pi.url, pi.favIcon, "
       "ci.probi, ci.date, pi.verified, pi.provider "
@@ -232,6 +302,14 @@ bool PublisherInfoDatabase::CreatePublisherInfoTable() {
   return GetDB().Execute(sql.c_str());
 }
 
+bool PublisherInfoDatabase::CreatePublisherInfoIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS publisher_info_verified_excluded_index "
+      "ON publisher_info (verified, excluded)");
+}
+
 bool PublisherInfoDatabase::InsertOrUpdatePublisherInfo(
     const ledger::PublisherInfo& info) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -243,6 +321,8 @@ bool PublisherInfoDatabase::InsertOrUpdatePublisherInfo(
     return false;
   }
 
+  FlushPendingWrites();
+
   sql::Transaction transaction(&GetDB());
   if (!transaction.Begin()) {
     return false;
@@ -300,6 +380,21 @@ PublisherInfoDatabase::GetPublisherInfo(const std::string& publisher_key) {
     return nullptr;
   }
 
+  auto pending = pending_publishers_.find(publisher_key);
+  if (pending != pending_publishers_.end()) {
+    std::unique_ptr<ledger::PublisherInfo> info;
+    info.reset(new ledger::PublisherInfo());
+    info->id = pending->second.id;
+    info->name = pending->second.name;
+    info->url = pending->second.url;
+    info->favicon_url = pending->second.favicon_url;
+    info->provider = pending->second.provider;
+    info->verified = pending->second.verified;
+    info->excluded = pending->second.excluded;
+
+    return info;
+  }
+
   sql::Statement info_sql(db_.GetUniqueStatement(
       "SELECT publisher_id, name, url, favIcon, provider, verified, excluded "
       "FROM publisher_info WHERE publisher_id=?"));
@@ -336,6 +431,28 @@ PublisherInfoDatabase::GetPanelPublisher(
     return nullptr;
   }
 
+  const ledger::PublisherInfo* pending =
+      GetPendingActivity(filter.id, filter.reconcile_stamp);
+  if (pending) {
+    const ledger::PublisherInfo& publisher = pending_publishers_[filter.id];
+    std::unique_ptr<ledger::PublisherInfo> info;
+    info.reset(new ledger::PublisherInfo());
+    info->id = publisher.id;
+    info->name = publisher.name;
+    info->url = publisher.url;
+    info->favicon_url = publisher.favicon_url;
+    info->provider = publisher.provider;
+    info->verified = publisher.verified;
+    info->excluded = publisher.excluded;
+    info->percent = pending->percent;
+
+    return info;
+  }
+
+  if (HasPendingPublisher(filter.id)) {
+    FlushPendingWrites();
+  }
+
   sql::Statement info_sql(db_.GetUniqueStatement(
       "SELECT pi.publisher_id, pi.name, pi.url, pi.favIcon, "
       "pi.provider, pi.verified, pi.excluded, "
@@ -378,6 +495,8 @@ bool PublisherInfoDatabase::RestorePublishers() {
     return false;
   }
 
+  FlushPendingWrites();
+
   sql::Statement restore_q(db_.GetUniqueStatement(
       "UPDATE publisher_info SET excluded=? WHERE excluded=?"));
 
@@ -399,6 +518,8 @@ int PublisherInfoDatabase::GetExcludedPublishersCount() {
     return 0;
   }
 
+  FlushPendingWrites();
+
   sql::Statement query(db_.GetUniqueStatement(
       "SELECT COUNT(*) FROM publisher_info WHERE excluded=?"));
 
@@ -452,7 +573,10 @@ bool PublisherInfoDatabase::CreateActivityInfoIndex() {
 
   return GetDB().Execute(
       "CREATE INDEX IF NOT EXISTS activity_info_publisher_id_index "
-      "ON activity_info (publisher_id)");
+      "ON activity_info (publisher_id)") &&
+      GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS activity_info_reconcile_stamp_index "
+      "ON activity_info (reconcile_stamp, duration, visits)");
 }
 
 bool PublisherInfoDatabase::InsertOrUpdateActivityInfo(
@@ -470,22 +594,7 @@ bool PublisherInfoDatabase::InsertOrUpdateActivityInfo(
     return false;
   }
 
-  sql::Statement activity_info_insert(
-    GetDB().GetCachedStatement(SQL_FROM_HERE,
-        "INSERT OR REPLACE INTO activity_info "
-        "(publisher_id, duration, score, percent, "
-        "weight, reconcile_stamp, visits) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?)"));
-
-  activity_info_insert.BindString(0, info.id);
-  activity_info_insert.BindInt64(1, static_cast<int>(info.duration));
-  activity_info_insert.BindDouble(2, info.score);
-  activity_info_insert.BindInt64(3, static_cast<int>(info.percent));
-  activity_info_insert.BindDouble(4, info.weight);
-  activity_info_insert.BindInt64(5, info.reconcile_stamp);
-  activity_info_insert.BindInt(6, info.visits);
-
-  return activity_info_insert.Run();
+  return WriteActivityInfo(info);
 }
 
 bool PublisherInfoDatabase::InsertOrUpdateActivityInfos(
@@ -514,6 +623,176 @@ bool PublisherInfoDatabase::InsertOrUpdateActivityInfos(
   return transaction.Commit();
 }
 
+bool PublisherInfoDatabase::QueuePublisherInfo(
+    const ledger::PublisherInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized || info.id.empty()) {
+    return false;
+  }
+
+  QueuePendingPublisher(info);
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kFlushPendingWritesDelay, this,
+        &PublisherInfoDatabase::OnFlushTimer);
+  }
+
+  return true;
+}
+
+bool PublisherInfoDatabase::QueueActivityInfo(
+    const ledger::PublisherInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!QueuePublisherInfo(info)) {
+    return false;
+  }
+
+  pending_activities_[std::make_pair(info.id, info.reconcile_stamp)] = info;
+  return true;
+}
+
+bool PublisherInfoDatabase::FlushPendingWrites() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  flush_timer_.Stop();
+
+  if (pending_publishers_.empty() && pending_activities_.empty()) {
+    return true;
+  }
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  for (const auto& publisher : pending_publishers_) {
+    if (!WritePublisherInfo(publisher.second)) {
+      transaction.Rollback();
+      return false;
+    }
+  }
+
+  for (const auto& activity : pending_activities_) {
+    if (!WriteActivityInfo(activity.second)) {
+      transaction.Rollback();
+      return false;
+    }
+  }
+
+  if (!transaction.Commit()) {
+    return false;
+  }
+
+  pending_publishers_.clear();
+  pending_activities_.clear();
+  return true;
+}
+
+void PublisherInfoDatabase::OnFlushTimer() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  ignore_result(FlushPendingWrites());
+}
+
+void PublisherInfoDatabase::QueuePendingPublisher(
+    const ledger::PublisherInfo& info) {
+  // An empty favicon keeps the current one and |_clear_favicon| clears it,
+  // see InsertOrUpdatePublisherInfo(). Resolve that here so the pending row
+  // holds the value that will end up on disk.
+  std::string favicon = info.favicon_url;
+  if (favicon.empty()) {
+    auto it = pending_publishers_.find(info.id);
+    favicon = it != pending_publishers_.end() ?
+        it->second.favicon_url : GetStoredFavIcon(info.id);
+  } else if (favicon == ledger::_clear_favicon) {
+    favicon.clear();
+  }
+
+  ledger::PublisherInfo& pending = pending_publishers_[info.id];
+  pending = info;
+  pending.favicon_url = favicon;
+}
+
+std::string PublisherInfoDatabase::GetStoredFavIcon(
+    const std::string& publisher_key) {
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT favIcon FROM publisher_info WHERE publisher_id = ?"));
+
+  statement.BindString(0, publisher_key);
+
+  if (statement.Step()) {
+    return statement.ColumnString(0);
+  }
+
+  return std::string();
+}
+
+bool PublisherInfoDatabase::HasPendingPublisher(
+    const std::string& publisher_key) const {
+  return pending_publishers_.find(publisher_key) != pending_publishers_.end();
+}
+
+const ledger::PublisherInfo* PublisherInfoDatabase::GetPendingActivity(
+    const std::string& publisher_key,
+    uint64_t reconcile_stamp) const {
+  auto it = pending_activities_.find(
+      std::make_pair(publisher_key, reconcile_stamp));
+  if (it == pending_activities_.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+bool PublisherInfoDatabase::WritePublisherInfo(
+    const ledger::PublisherInfo& info) {
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "INSERT OR REPLACE INTO publisher_info "
+      "(publisher_id, verified, excluded, name, url, provider, favIcon) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?)"));
+
+  statement.BindString(0, info.id);
+  statement.BindBool(1, info.verified);
+  statement.BindInt(2, static_cast<int>(info.excluded));
+  statement.BindString(3, info.name);
+  statement.BindString(4, info.url);
+  statement.BindString(5, info.provider);
+  statement.BindString(6, info.favicon_url);
+
+  return statement.Run();
+}
+
+bool PublisherInfoDatabase::WriteActivityInfo(
+    const ledger::PublisherInfo& info) {
+  sql::Statement activity_info_insert(
+    GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "INSERT OR REPLACE INTO activity_info "
+        "(publisher_id, duration, score, percent, "
+        "weight, reconcile_stamp, visits) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?)"));
+
+  activity_info_insert.BindString(0, info.id);
+  activity_info_insert.BindInt64(1, static_cast<int>(info.duration));
+  activity_info_insert.BindDouble(2, info.score);
+  activity_info_insert.BindInt64(3, static_cast<int>(info.percent));
+  activity_info_insert.BindDouble(4, info.weight);
+  activity_info_insert.BindInt64(5, info.reconcile_stamp);
+  activity_info_insert.BindInt(6, info.visits);
+
+  return activity_info_insert.Run();
+}
+
 bool PublisherInfoDatabase::GetActivityList(
     int start,
     int limit,
@@ -530,6 +809,39 @@ bool PublisherInfoDatabase::GetActivityList(
     return false;
   }
 
+  // (publisher_id, reconcile_stamp) is unique, so a lookup of a single
+  // queued row can be answered without touching the database.
+  const bool single_row = !filter.id.empty() && filter.reconcile_stamp > 0 &&
+      !(limit > 0 && start > 1);
+  const ledger::PublisherInfo* pending = single_row ?
+      GetPendingActivity(filter.id, filter.reconcile_stamp) : nullptr;
+  if (pending) {
+    const ledger::PublisherInfo& publisher = pending_publishers_[filter.id];
+    ledger::PublisherInfo info(filter.id);
+    info.duration = pending->duration;
+    info.score = pending->score;
+    info.percent = pending->percent;
+    info.weight = pending->weight;
+    info.verified = publisher.verified;
+    info.excluded = publisher.excluded;
+    info.name = publisher.name;
+    info.url = publisher.url;
+    info.provider = publisher.provider;
+    info.favicon_url = publisher.favicon_url;
+    info.reconcile_stamp = pending->reconcile_stamp;
+    info.visits = pending->visits;
+
+    if (MatchesActivityFilter(info, filter)) {
+      list->push_back(info);
+    }
+
+    return true;
+  }
+
+  if (!single_row || HasPendingPublisher(filter.id)) {
+    FlushPendingWrites();
+  }
+
   std::string query = "SELECT ai.publisher_id, ai.duration, ai.score, "
                       "ai.percent, ai.weight, pi.verified, pi.excluded, "
                       "pi.name, pi.url, pi.provider, "
@@ -574,20 +886,26 @@ bool PublisherInfoDatabase::GetActivityList(
     query += " AND pi.verified = 1";
   }
 
+  // Rows come back in insertion order unless asked otherwise, whichever
+  // index the planner picks.
+  query += " ORDER BY ";
   for (const auto& it : filter.order_by) {
-    query += " ORDER BY " + it.first;
-    query += (it.second ? " ASC" : " DESC");
-  }
-
-  if (limit > 0) {
-    query += " LIMIT " + std::to_string(limit);
-
-    if (start > 1) {
-      query += " OFFSET " + std::to_string(start);
+    if (!IsActivityListOrderColumn(it.first)) {
+      LOG(ERROR) << "DB: Unsupported activity list order " << it.first;
+      continue;
     }
+
+    query += it.first;
+    query += (it.second ? " ASC, " : " DESC, ");
   }
+  query += "ai.rowid LIMIT ? OFFSET ?";
 
-  sql::Statement info_sql(db_.GetUniqueStatement(query.c_str()));
+  // Only the shape of the filter ends up in |query|, so there is one cached
+  // statement per shape. The statement cache keeps a pointer to its key.
+  const char* statement_key =
+      activity_list_queries_.insert(query).first->c_str();
+  sql::Statement info_sql(GetDB().GetCachedStatement(
+      sql::StatementID(statement_key), statement_key));
 
   int column = 0;
   if (!filter.id.empty()) {
@@ -599,7 +917,7 @@ bool PublisherInfoDatabase::GetActivityList(
   }
 
   if (filter.min_duration > 0) {
-    info_sql.BindInt(column++, filter.min_duration);
+    info_sql.BindInt64(column++, filter.min_duration);
   }
 
   if (filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL &&
@@ -621,6 +939,10 @@ bool PublisherInfoDatabase::GetActivityList(
     info_sql.BindInt(column++, filter.min_visits);
   }
 
+  // A negative LIMIT means no limit
+  info_sql.BindInt(column++, limit > 0 ? limit : -1);
+  info_sql.BindInt(column++, limit > 0 && start > 1 ? start : 0);
+
   while (info_sql.Step()) {
     std::string id(info_sql.ColumnString(0));
 
@@ -657,6 +979,8 @@ bool PublisherInfoDatabase::DeleteActivityInfo(
     return false;
   }
 
+  FlushPendingWrites();
+
   sql::Statement statement(GetDB().GetCachedStatement(
       SQL_FROM_HERE,
       "DELETE FROM activity_info WHERE "
@@ -730,6 +1054,8 @@ PublisherInfoDatabase::GetMediaPublisherInfo(const std::string& media_key) {
     return nullptr;
   }
 
+  FlushPendingWrites();
+
   sql::Statement info_sql(db_.GetUniqueStatement(
       "SELECT pi.publisher_id, pi.name, pi.url, pi.favIcon, "
       "pi.provider, pi.verified, pi.excluded "
@@ -828,6 +1154,8 @@ void PublisherInfoDatabase::GetRecurringDonations(
     return;
   }
 
+  FlushPendingWrites();
+
   sql::Statement info_sql(db_.GetUniqueStatement(
       "SELECT pi.publisher_id, pi.name, pi.url, pi.favIcon, "
       "rd.amount, rd.added_date, pi.verified, pi.provider "
@@ -983,6 +1311,8 @@ void PublisherInfoDatabase::Vacuum() {
   if (!initialized_)
     return;
 
+  ignore_result(FlushPendingWrites());
+
   DCHECK_EQ(0, db_.transaction_nesting()) <<
       "Can not have a transaction when vacuuming.";
   ignore_result(db_.Execute("VACUUM"));
@@ -991,6 +1321,7 @@ void PublisherInfoDatabase::Vacuum() {
 void PublisherInfoDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  ignore_result(FlushPendingWrites());
   db_.TrimMemory();
 }
 
@@ -1195,6 +1526,19 @@ bool PublisherInfoDatabase::MigrateV5toV6() {
   return transaction.Commit();
 }
 
+bool PublisherInfoDatabase::MigrateV6toV7() {
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  if (!CreatePublisherInfoIndex() || !CreateActivityInfoIndex()) {
+    return false;
+  }
+
+  return transaction.Commit();
+}
+
 bool PublisherInfoDatabase::Migrate(int version) {
   switch (version) {
     case 2: {
@@ -1212,6 +1556,9 @@ bool PublisherInfoDatabase::Migrate(int version) {
     case 6: {
       return MigrateV5toV6();
     }
+    case 7: {
+      return MigrateV6toV7();
+    }
     default:
       return false;
   }
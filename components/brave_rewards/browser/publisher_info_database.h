@@ -5,14 +5,20 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_PUBLISHER_INFO_DATABASE_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_PUBLISHER_INFO_DATABASE_H_
 
-#include <memory>
 #include <stddef.h>
 
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/sequence_checker.h"
+#include "base/timer/timer.h"
 #include "bat/ledger/publisher_info.h"
 #include "bat/ledger/pending_contribution.h"
 #include "brave/components/brave_rewards/browser/contribution_info.h"
@@ -58,6 +64,17 @@ class PublisherInfoDatabase {
 
   bool InsertOrUpdateActivityInfos(const ledger::PublisherInfoList& list);
 
+  // Write-behind variants of InsertOrUpdatePublisherInfo() and
+  // InsertOrUpdateActivityInfo(). Updates are coalesced per publisher in
+  // memory and written in a single transaction by FlushPendingWrites(), which
+  // runs on a timer, under memory pressure and on destruction. Readers see
+  // the pending values.
+  bool QueuePublisherInfo(const ledger::PublisherInfo& info);
+
+  bool QueueActivityInfo(const ledger::PublisherInfo& info);
+
+  bool FlushPendingWrites();
+
   bool GetActivityList(int start,
                        int limit,
                        const ledger::ActivityInfoFilter& filter,
@@ -107,6 +124,8 @@ class PublisherInfoDatabase {
 
   bool CreatePublisherInfoTable();
 
+  bool CreatePublisherInfoIndex();
+
   bool CreateActivityInfoTable();
 
   bool CreateActivityInfoIndex();
@@ -119,6 +138,22 @@ class PublisherInfoDatabase {
   bool CreatePendingContributionsTable();
   bool CreatePendingContributionsIndex();
 
+  bool WritePublisherInfo(const ledger::PublisherInfo& info);
+
+  bool WriteActivityInfo(const ledger::PublisherInfo& info);
+
+  void QueuePendingPublisher(const ledger::PublisherInfo& info);
+
+  std::string GetStoredFavIcon(const std::string& publisher_key);
+
+  bool HasPendingPublisher(const std::string& publisher_key) const;
+
+  const ledger::PublisherInfo* GetPendingActivity(
+      const std::string& publisher_key,
+      uint64_t reconcile_stamp) const;
+
+  void OnFlushTimer();
+
   void OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
@@ -134,10 +169,15 @@ class PublisherInfoDatabase {
 
   bool MigrateV5toV6();
 
+  bool MigrateV6toV7();
+
   bool Migrate(int version);
 
   sql::InitStatus EnsureCurrentVersion();
 
+  // Interned GetActivityList() queries, which key the statement cache of
+  // |db_| and therefore have to outlive it.
+  std::set<std::string> activity_list_queries_;
   sql::Database db_;
   sql::MetaTable meta_table_;
   const base::FilePath db_path_;
@@ -146,6 +186,14 @@ class PublisherInfoDatabase {
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
+  // Latest queued publisher_info rows by publisher id, with the favicon
+  // already resolved so they can be written and read back as-is.
+  std::map<std::string, ledger::PublisherInfo> pending_publishers_;
+  // Latest queued activity_info rows by (publisher id, reconcile stamp).
+  std::map<std::pair<std::string, uint64_t>, ledger::PublisherInfo>
+      pending_activities_;
+  base::OneShotTimer flush_timer_;
+
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(PublisherInfoDatabase);
 };
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <streambuf>
 #include <string>
+#include <vector>
 
 #include "brave/components/brave_rewards/browser/publisher_info_database.h"
 
@@ -14,6 +15,8 @@
 #include "base/path_service.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/common/brave_paths.h"
 #include "sql/database.h"
 #include "sql/statement.h"
@@ -27,7 +30,9 @@ namespace brave_rewards {
 
 class PublisherInfoDatabaseTest : public ::testing::Test {
  protected:
-  PublisherInfoDatabaseTest() {
+  PublisherInfoDatabaseTest() :
+      scoped_task_environment_(
+          base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME) {
   }
 
   ~PublisherInfoDatabaseTest() override {
@@ -90,6 +95,18 @@ class PublisherInfoDatabaseTest : public ::testing::Test {
     return static_cast<int>(s.ColumnInt64(0));
   }
 
+  std::vector<std::string> GetIndexColumns(const std::string& index) {
+    std::vector<std::string> columns;
+    std::string sql = "PRAGMA index_info(" + index + ")";
+    sql::Statement s(GetDB().GetUniqueStatement(sql.c_str()));
+    while (s.Step()) {
+      columns.push_back(s.ColumnString(2));
+    }
+
+    return columns;
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   std::unique_ptr<PublisherInfoDatabase> publisher_info_database_;
 };
 
@@ -744,6 +761,43 @@ TEST_F(PublisherInfoDatabaseTest, GetActivityList) {
 
   EXPECT_EQ(list_4.at(0).id, "publisher_5");
   EXPECT_EQ(list_4.at(1).id, "publisher_6");
+
+  /**
+   * Order by several columns, one page at a time
+  */
+  ledger::ActivityInfoFilter filter_5;
+  filter_5.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter_5.order_by.push_back(std::make_pair("ai.visits", false));
+  filter_5.order_by.push_back(std::make_pair("ai.duration", true));
+  ledger::PublisherInfoList list_5;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 0, filter_5, &list_5));
+  EXPECT_EQ(static_cast<int>(list_5.size()), 6);
+
+  EXPECT_EQ(list_5.at(0).id, "publisher_5");
+  EXPECT_EQ(list_5.at(1).id, "publisher_6");
+  EXPECT_EQ(list_5.at(2).id, "publisher_3");
+  EXPECT_EQ(list_5.at(3).id, "publisher_4");
+  EXPECT_EQ(list_5.at(4).id, "publisher_2");
+  EXPECT_EQ(list_5.at(5).id, "publisher_1");
+
+  ledger::PublisherInfoList list_6;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(2, 3, filter_5, &list_6));
+  EXPECT_EQ(static_cast<int>(list_6.size()), 3);
+
+  EXPECT_EQ(list_6.at(0).id, "publisher_3");
+  EXPECT_EQ(list_6.at(1).id, "publisher_4");
+  EXPECT_EQ(list_6.at(2).id, "publisher_2");
+
+  /**
+   * Unsupported order columns are ignored
+  */
+  ledger::ActivityInfoFilter filter_7;
+  filter_7.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter_7.order_by.push_back(std::make_pair("1; DROP TABLE x", true));
+  ledger::PublisherInfoList list_7;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 0, filter_7, &list_7));
+  EXPECT_EQ(static_cast<int>(list_7.size()), 6);
+  EXPECT_EQ(list_7.at(0).id, "publisher_1");
 }
 
 TEST_F(PublisherInfoDatabaseTest, Migrationv4tov5) {
@@ -825,6 +879,39 @@ TEST_F(PublisherInfoDatabaseTest, Migrationv4tov6) {
   EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 6);
 }
 
+TEST_F(PublisherInfoDatabaseTest, Migrationv6tov7) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateMigrationDatabase(&temp_dir, &db_file, 6, 7);
+
+  ledger::PublisherInfoList list;
+  ledger::ActivityInfoFilter filter;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 0, filter, &list));
+  EXPECT_EQ(static_cast<int>(list.size()), 3);
+
+  EXPECT_EQ(list.at(0).id, "basicattentiontoken.org");
+  EXPECT_EQ(list.at(0).duration, 31u);
+  EXPECT_EQ(list.at(0).visits, 1u);
+  EXPECT_EQ(list.at(0).reconcile_stamp, 1553423066u);
+  EXPECT_EQ(list.at(1).id, "brave.com");
+  EXPECT_EQ(list.at(1).duration, 20u);
+  EXPECT_EQ(list.at(1).visits, 2u);
+  EXPECT_EQ(list.at(2).id, "slo-tech.com");
+  EXPECT_EQ(list.at(2).duration, 44u);
+  EXPECT_EQ(list.at(2).visits, 2u);
+  EXPECT_EQ(CountTableRows("publisher_info"), 3);
+  EXPECT_EQ(CountTableRows("activity_info"), 3);
+
+  EXPECT_EQ(GetIndexColumns("activity_info_reconcile_stamp_index"),
+            std::vector<std::string>({"reconcile_stamp", "duration",
+                                      "visits"}));
+  EXPECT_EQ(GetIndexColumns("publisher_info_verified_excluded_index"),
+            std::vector<std::string>({"verified", "excluded"}));
+
+  EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 7);
+}
+
 TEST_F(PublisherInfoDatabaseTest, GetExcludedPublishersCount) {
   base::ScopedTempDir temp_dir;
   base::FilePath db_file;
@@ -915,4 +1002,161 @@ TEST_F(PublisherInfoDatabaseTest, DeleteActivityInfo) {
 
 }
 
+TEST_F(PublisherInfoDatabaseTest, QueueActivityInfo) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::PublisherInfo info;
+  info.id = "publisher_1";
+  info.verified = true;
+  info.excluded = ledger::PUBLISHER_EXCLUDE::DEFAULT;
+  info.name = "publisher1";
+  info.url = "https://publisher1.com";
+  info.favicon_url = "favicon.ico";
+  info.duration = 10;
+  info.score = 1.1;
+  info.percent = 33;
+  info.weight = 1.5;
+  info.reconcile_stamp = 1;
+  info.visits = 1;
+
+  EXPECT_TRUE(publisher_info_database_->QueueActivityInfo(info));
+
+  info.duration = 20;
+  info.visits = 2;
+  info.favicon_url = "";
+  EXPECT_TRUE(publisher_info_database_->QueueActivityInfo(info));
+
+  // Nothing is written yet
+  EXPECT_EQ(CountTableRows("activity_info"), 0);
+  EXPECT_EQ(CountTableRows("publisher_info"), 0);
+
+  // Point lookups are served from the queue
+  ledger::ActivityInfoFilter filter;
+  filter.id = info.id;
+  filter.reconcile_stamp = info.reconcile_stamp;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter.non_verified = true;
+  ledger::PublisherInfoList list;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 2, filter, &list));
+  ASSERT_EQ(list.size(), 1u);
+  EXPECT_EQ(list.at(0).duration, 20u);
+  EXPECT_EQ(list.at(0).visits, 2u);
+  EXPECT_EQ(list.at(0).favicon_url, "favicon.ico");
+  EXPECT_EQ(CountTableRows("activity_info"), 0);
+
+  auto panel = publisher_info_database_->GetPanelPublisher(filter);
+  ASSERT_TRUE(panel);
+  EXPECT_EQ(panel->percent, 33u);
+  EXPECT_EQ(panel->name, "publisher1");
+
+  auto publisher = publisher_info_database_->GetPublisherInfo(info.id);
+  ASSERT_TRUE(publisher);
+  EXPECT_EQ(publisher->url, "https://publisher1.com");
+
+  // Queued rows are coalesced and written on the timer
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(CountTableRows("activity_info"), 1);
+  EXPECT_EQ(CountTableRows("publisher_info"), 1);
+
+  list.clear();
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 2, filter, &list));
+  ASSERT_EQ(list.size(), 1u);
+  EXPECT_EQ(list.at(0).duration, 20u);
+  EXPECT_EQ(list.at(0).visits, 2u);
+  EXPECT_EQ(list.at(0).favicon_url, "favicon.ico");
+}
+
+TEST_F(PublisherInfoDatabaseTest, QueuePublisherInfoFlushesBeforeQueries) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::PublisherInfo info;
+  info.id = "publisher_1";
+  info.verified = true;
+  info.excluded = ledger::PUBLISHER_EXCLUDE::DEFAULT;
+  info.name = "publisher1";
+  info.url = "https://publisher1.com";
+  info.favicon_url = "favicon.ico";
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdatePublisherInfo(info));
+
+  // Empty favicon keeps the stored one
+  info.favicon_url = "";
+  info.excluded = ledger::PUBLISHER_EXCLUDE::EXCLUDED;
+  EXPECT_TRUE(publisher_info_database_->QueuePublisherInfo(info));
+  auto publisher = publisher_info_database_->GetPublisherInfo(info.id);
+  ASSERT_TRUE(publisher);
+  EXPECT_EQ(publisher->favicon_url, "favicon.ico");
+
+  // Aggregate queries see queued rows
+  EXPECT_EQ(publisher_info_database_->GetExcludedPublishersCount(), 1);
+
+  info.favicon_url = ledger::_clear_favicon;
+  EXPECT_TRUE(publisher_info_database_->QueuePublisherInfo(info));
+  EXPECT_TRUE(publisher_info_database_->FlushPendingWrites());
+
+  std::string query = "SELECT favIcon FROM publisher_info WHERE publisher_id=?";
+  sql::Statement info_sql(GetDB().GetUniqueStatement(query.c_str()));
+  info_sql.BindString(0, info.id);
+  EXPECT_TRUE(info_sql.Step());
+  EXPECT_EQ(info_sql.ColumnString(0), "");
+
+  // Publisher key is missing
+  info.id = "";
+  EXPECT_FALSE(publisher_info_database_->QueuePublisherInfo(info));
+}
+
+// Run with --gtest_also_run_disabled_tests to time the auto-contribute
+// query against a large profile.
+TEST_F(PublisherInfoDatabaseTest, DISABLED_Benchmark) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  const int kPublisherCount = 50000;
+  ledger::PublisherInfoList publishers;
+  for (int i = 0; i < kPublisherCount; ++i) {
+    ledger::PublisherInfo info;
+    info.id = "publisher_" + std::to_string(i);
+    info.name = "publisher_name_" + std::to_string(i);
+    info.url = "https://" + info.id + ".com";
+    info.duration = i % 120;
+    info.visits = i % 7;
+    info.verified = i % 3 == 0;
+    info.excluded = i % 50 == 0 ?
+        ledger::PUBLISHER_EXCLUDE::EXCLUDED :
+        ledger::PUBLISHER_EXCLUDE::DEFAULT;
+    info.reconcile_stamp = i % 4 == 0 ? 1 : 2;
+    publishers.push_back(info);
+  }
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdateActivityInfos(
+      publishers));
+
+  ledger::ActivityInfoFilter filter;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED;
+  filter.min_duration = 8;
+  filter.min_visits = 1;
+  filter.reconcile_stamp = 2;
+  filter.non_verified = false;
+  filter.order_by.push_back(std::make_pair("ai.percent", false));
+
+  const int kIterations = 20;
+  size_t rows = 0;
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    ledger::PublisherInfoList list;
+    EXPECT_TRUE(publisher_info_database_->GetActivityList(
+        0, 0, filter, &list));
+    rows = list.size();
+  }
+
+  EXPECT_GT(rows, 0u);
+  LOG(INFO) << "Listed " << rows << " of " << kPublisherCount
+            << " publishers in "
+            << timer.Elapsed().InMicroseconds() / kIterations
+            << "us per query";
+}
+
 }  // namespace brave_rewards
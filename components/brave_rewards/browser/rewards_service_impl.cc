@@ -223,7 +223,7 @@ LoadMediaPublisherInfoOnFileTaskRunner(
 bool SavePublisherInfoOnFileTaskRunner(
     const ledger::PublisherInfo publisher_info,
     PublisherInfoDatabase* backend) {
-  if (backend && backend->InsertOrUpdatePublisherInfo(publisher_info))
+  if (backend && backend->QueuePublisherInfo(publisher_info))
     return true;
 
   return false;
@@ -232,7 +232,7 @@ bool SavePublisherInfoOnFileTaskRunner(
 bool SaveActivityInfoOnFileTaskRunner(
     const ledger::PublisherInfo publisher_info,
     PublisherInfoDatabase* backend) {
-  if (backend && backend->InsertOrUpdateActivityInfo(publisher_info))
+  if (backend && backend->QueueActivityInfo(publisher_info))
     return true;
 
   return false;
@@ -528,7 +528,7 @@ void RewardsServiceImpl::OnLoad(SessionID tab_id, const GURL& url) {
                          publisher_url,
                          "",
                          "");
-  bat_ledger_->OnLoad(data.ToJson(), GetCurrentTimestamp());
+  bat_ledger_->OnLoad(data, GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnUnload(SessionID tab_id) {
@@ -613,7 +613,7 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
                           first_party_url.spec(),
                           referrer.spec(),
                           output,
-                          visit_data.ToJson());
+                          visit_data);
 }
 
 void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
@@ -643,7 +643,7 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
                          mojo::MapToFlatMap(parts),
                          first_party_url.spec(),
                          referrer.spec(),
-                         data.ToJson());
+                         data);
 }
 
 void RewardsServiceImpl::LoadPublisherInfo(
@@ -1803,14 +1803,7 @@ void RewardsServiceImpl::OnPublisherListLoaded(
 
 void RewardsServiceImpl::OnGetAllBalanceReports(
     const GetAllBalanceReportsCallback& callback,
-    const base::flat_map<std::string, std::string>& json_reports) {
-  std::map<std::string, ledger::BalanceReportInfo> reports;
-  for (auto const& report : json_reports) {
-    ledger::BalanceReportInfo info;
-    info.loadFromJson(report.second);
-    reports[report.first] = info;
-  }
-
+    const base::flat_map<std::string, ledger::BalanceReportInfo>& reports) {
   std::map<std::string, brave_rewards::BalanceReport> newReports;
   for (auto const& report : reports) {
     brave_rewards::BalanceReport newReport;
@@ -1841,10 +1834,7 @@ void RewardsServiceImpl::GetAllBalanceReports(
 }
 
 void RewardsServiceImpl::OnGetCurrentBalanceReport(
-    bool success, const std::string& json_report) {
-  ledger::BalanceReportInfo report;
-  report.loadFromJson(json_report);
-
+    bool success, const ledger::BalanceReportInfo& report) {
   if (success) {
     TriggerOnGetCurrentBalanceReport(report);
   }
@@ -1903,7 +1893,7 @@ void RewardsServiceImpl::GetPublisherActivityFromUrl(
   visitData.favicon_url = favicon_url;
 
   bat_ledger_->GetPublisherActivityFromUrl(
-    windowId, visitData.ToJson(), publisher_blob);
+    windowId, visitData, publisher_blob);
 }
 
 void RewardsServiceImpl::OnExcludedSitesChanged(
@@ -2106,7 +2096,7 @@ void RewardsServiceImpl::OnDonate(const std::string& publisher_key, int amount,
 
   ledger::PublisherInfo publisher(publisher_key);
 
-  bat_ledger_->DoDirectDonation(publisher.ToJson(), amount, "BAT");
+  bat_ledger_->DoDirectDonation(publisher, amount, "BAT");
 }
 
 bool SaveContributionInfoOnFileTaskRunner(
@@ -432,9 +432,9 @@ class RewardsServiceImpl : public RewardsService,
       const std::string& transactions);
   void OnGetAllBalanceReports(
       const GetAllBalanceReportsCallback& callback,
-      const base::flat_map<std::string, std::string>& json_reports);
+      const base::flat_map<std::string, ledger::BalanceReportInfo>& reports);
   void OnGetCurrentBalanceReport(
-      bool success, const std::string& json_report);
+      bool success, const ledger::BalanceReportInfo& report);
   void OnGetAddresses(
       const GetAddressesCallback& callback,
       const base::flat_map<std::string, std::string>& addresses);
@@ -24,10 +24,6 @@
 #include "brave/vendor/ad-block/ad_block_client.h"
 #include "chrome/browser/profiles/profile_manager.h"
 #include "components/prefs/pref_service.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
-
-using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
@@ -103,9 +99,11 @@ FilterOption ResourceTypeToFilterOption(content::ResourceType resource_type) {
 namespace brave_shields {
 
 AdBlockBaseService::AdBlockBaseService()
-    : BaseBraveShieldsService(),
-      ad_block_client_(new AdBlockClient()),
-      weak_factory_(this) {
+    : BaseBraveShieldsService() {
+  std::vector<std::unique_ptr<AdBlockClient>> clients;
+  clients.push_back(std::make_unique<AdBlockClient>());
+  ad_block_clients_ =
+      std::make_shared<MatcherPool<AdBlockClient>>(std::move(clients));
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -114,31 +112,48 @@ AdBlockBaseService::~AdBlockBaseService() {
 }
 
 void AdBlockBaseService::Cleanup() {
-  ad_block_client_.reset();
+  base::AutoLock lock(ad_block_clients_lock_);
+  ad_block_clients_.reset();
 }
 
 bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
     content::ResourceType resource_type, const std::string& tab_host,
     bool* did_match_exception, bool* cancel_request_explicitly) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  FilterOption current_option = ResourceTypeToFilterOption(resource_type);
-
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  if (SameDomainOrHost(url, url::Origin::CreateFromNormalizedTuple(
-        "https", tab_host.c_str(), 80), INCLUDE_PRIVATE_REGISTRIES)) {
-    current_option = static_cast<FilterOption>(
-        current_option | FONotThirdParty);
-  } else {
-    current_option = static_cast<FilterOption>(current_option | FOThirdParty);
+  ShieldsRequest request(url, resource_type, tab_host);
+  return ShouldStartRequest(request, did_match_exception,
+                            cancel_request_explicitly);
+}
+
+bool AdBlockBaseService::ShouldStartRequest(const ShieldsRequest& request,
+    bool* did_match_exception, bool* cancel_request_explicitly) {
+  std::shared_ptr<MatcherPool<AdBlockClient>> ad_block_clients =
+      GetAdBlockClients();
+  if (!ad_block_clients) {
+    if (did_match_exception) {
+      *did_match_exception = false;
+    }
+    return true;
   }
 
+  // Third-party is determined up front so the library doesn't need to
+  // figure it out.
+  FilterOption current_option = static_cast<FilterOption>(
+      ResourceTypeToFilterOption(request.resource_type) |
+      (request.is_third_party ? FOThirdParty : FONotThirdParty));
+
   Filter* matching_filter = nullptr;
   Filter* matching_exception_filter = nullptr;
-  if (ad_block_client_->matches(url.spec().c_str(),
-        current_option, tab_host.c_str(), &matching_filter,
-        &matching_exception_filter)) {
+  bool matches = false;
+  {
+    // matches() writes to the client's stats and bloom filter counters, so it
+    // runs on a client that no other lookup is using.
+    MatcherPool<AdBlockClient>::ScopedMatcher ad_block_client =
+        ad_block_clients->Acquire();
+    matches = ad_block_client->matches(request.spec.c_str(),
+        current_option, request.tab_host.c_str(), &matching_filter,
+        &matching_exception_filter);
+  }
+  if (matches) {
     if (matching_filter && cancel_request_explicitly &&
         (matching_filter->filterOption & FOExplicitCancel)) {
       *cancel_request_explicitly = true;
@@ -146,9 +161,9 @@ bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
     // We'd only possibly match an exception filter if we're returning true.
     *did_match_exception = false;
     // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
+    //  << request.tab_host
+    //  << ", resource type: " << request.resource_type
+    //  << ", url.spec(): " << request.spec;
     return false;
   }
 
@@ -169,40 +184,90 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
 void AdBlockBaseService::EnableTagOnFileTaskRunner(
     std::string tag, bool enabled) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (enabled) {
-    ad_block_client_->addTag(tag);
-  } else {
-    ad_block_client_->removeTag(tag);
+  bool changed = enabled ? tags_.insert(tag).second : tags_.erase(tag) > 0;
+  if (changed) {
+    ResetAdBlockClient();
   }
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
-  GetTaskRunner()->PostTaskAndReply(
+  GetTaskRunner()->PostTask(
       FROM_HERE,
-      base::Bind(&brave_shields::GetDATFileData, dat_file_path, &buffer_),
-      base::Bind(&AdBlockBaseService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
+      base::BindOnce(&AdBlockBaseService::GetDATFileDataOnTaskRunner,
+                     base::Unretained(this), dat_file_path));
 }
 
-void AdBlockBaseService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
+void AdBlockBaseService::GetDATFileDataOnTaskRunner(
+    const base::FilePath& dat_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::shared_ptr<DATFileData> buffer = LoadDATFileData(dat_file_path);
+  if (!buffer) {
     LOG(ERROR) << "Could not obtain ad block data";
     return;
   }
-  if (!ad_block_client_->deserialize(
-      reinterpret_cast<char*>(&buffer_.front()))) {
-    ad_block_client_.reset(new AdBlockClient());
-    LOG(ERROR) << "Failed to deserialize ad block data";
-    return;
+  buffer_ = buffer;
+  ResetAdBlockClient();
+}
+
+void AdBlockBaseService::ResetAdBlockClient() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::vector<std::unique_ptr<AdBlockClient>> clients;
+  const size_t pool_size = GetMatcherPoolSize();
+  while (clients.size() < pool_size) {
+    std::unique_ptr<AdBlockClient> client(new AdBlockClient());
+    if (buffer_ && !client->deserialize(buffer_->data())) {
+      LOG(ERROR) << "Failed to deserialize ad block data";
+      client.reset(new AdBlockClient());
+      buffer_.reset();
+      clients.clear();
+    }
+    if (!rules_for_test_.empty()) {
+      client->parse(rules_for_test_.c_str());
+    }
+    for (const std::string& tag : tags_) {
+      client->addTag(tag);
+    }
+    clients.push_back(std::move(client));
   }
+
+  // A deserialized client points into the DAT data, so every published
+  // pool keeps its data alive until the last matcher releases it.
+  std::shared_ptr<DATFileData> buffer = buffer_;
+  std::shared_ptr<MatcherPool<AdBlockClient>> new_clients(
+      new MatcherPool<AdBlockClient>(std::move(clients)),
+      [buffer](MatcherPool<AdBlockClient>* clients) { delete clients; });
+
+  base::AutoLock lock(ad_block_clients_lock_);
+  ad_block_clients_.swap(new_clients);
+}
+
+std::shared_ptr<MatcherPool<AdBlockClient>>
+AdBlockBaseService::GetAdBlockClients() {
+  base::AutoLock lock(ad_block_clients_lock_);
+  return ad_block_clients_;
 }
 
 bool AdBlockBaseService::Init() {
   return true;
 }
 
-AdBlockClient* AdBlockBaseService::GetAdBlockClientForTest() {
-  return ad_block_client_.get();
+std::shared_ptr<AdBlockClient> AdBlockBaseService::GetAdBlockClientForTest() {
+  std::shared_ptr<MatcherPool<AdBlockClient>> clients = GetAdBlockClients();
+  return std::shared_ptr<AdBlockClient>(clients, clients->front());
+}
+
+void AdBlockBaseService::AddRulesForTest(const std::string& rules) {
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockBaseService::AddRulesForTestOnTaskRunner,
+                     base::Unretained(this), rules));
+}
+
+void AdBlockBaseService::AddRulesForTestOnTaskRunner(
+    const std::string& rules) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  rules_for_test_ += rules + "\n";
+  ResetAdBlockClient();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -9,14 +9,17 @@
 #include <stdint.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/matcher_pool.h"
+#include "brave/components/brave_shields/browser/shields_request.h"
 #include "content/public/common/resource_type.h"
 
 class AdBlockClient;
@@ -26,14 +29,25 @@ namespace brave_shields {
 
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
+//
+// The rules of a published AdBlockClient never change: list updates and tag
+// changes build new clients on the task runner and atomically swap them in
+// (copy-on-write). AdBlockClient::matches() updates per-client stats and
+// bloom filter counters, so each list keeps a small pool of identical
+// clients and every lookup takes one that is not in use.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
   AdBlockBaseService();
   ~AdBlockBaseService() override;
 
+  // Can be called from any thread.
   bool ShouldStartRequest(const GURL &url, content::ResourceType resource_type,
     const std::string& tab_host, bool* did_match_exception,
     bool* cancel_request_explicitly) override;
+  // Same as above for a request that is checked against several lists.
+  bool ShouldStartRequest(const ShieldsRequest& request,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly);
   void EnableTag(const std::string& tag, bool enabled);
 
  protected:
@@ -43,17 +57,27 @@ class AdBlockBaseService : public BaseBraveShieldsService {
 
   void EnableTagOnFileTaskRunner(std::string tag, bool enabled);
   void GetDATFileData(const base::FilePath& dat_file_path);
-  AdBlockClient* GetAdBlockClientForTest();
+  // Builds a new client from |buffer_| and the enabled tags and publishes it
+  // for matching. Must run on the task runner.
+  void ResetAdBlockClient();
+  std::shared_ptr<MatcherPool<AdBlockClient>> GetAdBlockClients();
+  std::shared_ptr<AdBlockClient> GetAdBlockClientForTest();
+  void AddRulesForTest(const std::string& rules);
 
   SEQUENCE_CHECKER(sequence_checker_);
-  std::unique_ptr<AdBlockClient> ad_block_client_;
-  DATFileDataBuffer buffer_;
+  std::shared_ptr<DATFileData> buffer_;
 
  private:
-  void OnDATFileDataReady();
+  void GetDATFileDataOnTaskRunner(const base::FilePath& dat_file_path);
+  void AddRulesForTestOnTaskRunner(const std::string& rules);
   void OnPreferenceChanges(const std::string& pref_name);
 
-  base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
+  std::set<std::string> tags_;
+  std::string rules_for_test_;
+
+  base::Lock ad_block_clients_lock_;
+  std::shared_ptr<MatcherPool<AdBlockClient>> ad_block_clients_;
+
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
 
@@ -5,17 +5,121 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/logging.h"
+#include "base/path_service.h"
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 #include "brave/browser/brave_browser_process_impl.h"
+#include "brave/browser/version_info.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/vendor/ad-block/ad_block_client.h"
+#include "chrome/common/chrome_paths.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_thread.h"
 
+#define CUSTOM_FILTERS_CACHE_FILE "AdBlockCustomFilters.dat"
+// Bump when the layout of the cache file changes.
+#define CUSTOM_FILTERS_CACHE_FORMAT_VERSION "1"
+
+namespace {
+
+// Splits the filter text into its rules. Blank lines and comments don't
+// affect matching, so they are dropped and don't cause a rebuild.
+std::set<std::string> GetCustomFilterRules(const std::string& custom_filters) {
+  std::set<std::string> rules;
+  for (const std::string& line : base::SplitString(custom_filters, "\n",
+           base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (line[0] != '!') {
+      rules.insert(line);
+    }
+  }
+  return rules;
+}
+
+std::string JoinRules(const std::vector<std::string>& rules) {
+  return base::JoinString(rules, "\n");
+}
+
+std::string GetRulesHash(const std::set<std::string>& rules) {
+  std::string hash = base::SHA1HashString(
+      JoinRules(std::vector<std::string>(rules.begin(), rules.end())));
+  return base::HexEncode(hash.data(), hash.size());
+}
+
+base::FilePath GetCustomFiltersCachePath() {
+  base::FilePath user_data_dir;
+  if (!base::PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    return base::FilePath();
+  }
+  return user_data_dir.AppendASCII(CUSTOM_FILTERS_CACHE_FILE);
+}
+
+// The first line of the cache identifies what it was built from: the cache
+// format, the browser version (which pins the ad-block library and so its
+// serialization format) and the hash of the rules. The serialized client
+// follows.
+std::string GetCustomFiltersCacheHeader(const std::string& hash) {
+  return std::string(CUSTOM_FILTERS_CACHE_FORMAT_VERSION) + " " +
+      version_info::GetBraveVersionNumberForDisplay() + " " + hash + "\n";
+}
+
+std::unique_ptr<brave_shields::DATFileData> ReadCustomFiltersCache(
+    const std::string& hash) {
+  base::FilePath cache_path = GetCustomFiltersCachePath();
+  std::string contents;
+  if (cache_path.empty() || !base::PathExists(cache_path) ||
+      !base::ReadFileToString(cache_path, &contents)) {
+    return nullptr;
+  }
+  const std::string header = GetCustomFiltersCacheHeader(hash);
+  if (contents.size() <= header.size() ||
+      contents.compare(0, header.size(), header) != 0) {
+    return nullptr;
+  }
+  auto data = std::make_unique<brave_shields::DATFileData>(
+      brave_shields::DATFileDataBuffer(contents.begin() + header.size(),
+                                       contents.end()));
+
+  // Only hand out a list that is known to deserialize. A cache that doesn't
+  // is deleted so that it is rebuilt from the rules.
+  if (!AdBlockClient().deserialize(data->data())) {
+    LOG(ERROR) << "Custom filters cache is corrupt, rebuilding it";
+    base::DeleteFile(cache_path, false);
+    return nullptr;
+  }
+  return data;
+}
+
+void WriteCustomFiltersCache(const std::string& hash,
+                             const brave_shields::DATFileData& data) {
+  base::FilePath cache_path = GetCustomFiltersCachePath();
+  if (cache_path.empty()) {
+    return;
+  }
+  std::string contents = GetCustomFiltersCacheHeader(hash);
+  contents.append(data.data(), data.size());
+  if (!base::ImportantFileWriter::WriteFileAtomically(cache_path, contents)) {
+    LOG(ERROR) << "Could not write custom filters cache " << cache_path;
+  }
+}
+
+}  // namespace
+
 namespace brave_shields {
 
-AdBlockCustomFiltersService::AdBlockCustomFiltersService() {
+AdBlockCustomFiltersService::AdBlockCustomFiltersService()
+    : custom_rules_loaded_(false) {
 }
 
 AdBlockCustomFiltersService::~AdBlockCustomFiltersService() {
@@ -53,9 +157,67 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
 void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  ad_block_client_->clear();
-  if (!custom_filters.empty())
-    ad_block_client_->parse(custom_filters.c_str());
+  std::set<std::string> rules = GetCustomFilterRules(custom_filters);
+  if (custom_rules_loaded_ && rules == custom_rules_) {
+    return;
+  }
+
+  std::shared_ptr<DATFileData> buffer;
+  if (!rules.empty()) {
+    std::string hash = GetRulesHash(rules);
+    if (!custom_rules_loaded_) {
+      // On startup, reuse the list serialized by an earlier session if the
+      // rules haven't changed since.
+      buffer = ReadCustomFiltersCache(hash);
+    }
+    if (!buffer) {
+      buffer = BuildCustomFiltersData(rules);
+      if (!buffer) {
+        // Keep the current list and rules, so the next update retries.
+        return;
+      }
+      WriteCustomFiltersCache(hash, *buffer);
+    }
+  }
+
+  buffer_ = std::move(buffer);
+  custom_rules_ = std::move(rules);
+  custom_rules_loaded_ = true;
+  ResetAdBlockClient();
+}
+
+std::shared_ptr<DATFileData>
+AdBlockCustomFiltersService::BuildCustomFiltersData(
+    const std::set<std::string>& rules) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::unique_ptr<AdBlockClient> client(new AdBlockClient());
+  std::vector<std::string> rules_to_parse;
+  // The ad-block library can't remove a filter, so only additions are
+  // applied on top of the current list and any removal reparses everything.
+  if (buffer_ &&
+      std::includes(rules.begin(), rules.end(),
+                    custom_rules_.begin(), custom_rules_.end()) &&
+      client->deserialize(buffer_->data())) {
+    std::set_difference(rules.begin(), rules.end(),
+                        custom_rules_.begin(), custom_rules_.end(),
+                        std::back_inserter(rules_to_parse));
+  } else {
+    client.reset(new AdBlockClient());
+    rules_to_parse.assign(rules.begin(), rules.end());
+  }
+  client->parse(JoinRules(rules_to_parse).c_str());
+
+  int size = 0;
+  char* data = client->serialize(&size);
+  if (!data || size <= 0) {
+    LOG(ERROR) << "Failed to serialize custom filters";
+    delete[] data;
+    return nullptr;
+  }
+  auto buffer =
+      std::make_shared<DATFileData>(DATFileDataBuffer(data, data + size));
+  delete[] data;
+  return buffer;
 }
 
 scoped_refptr<base::SequencedTaskRunner>
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CUSTOM_FILTERS_SERVICE_H_
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
@@ -32,6 +33,16 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
  private:
   friend class ::AdBlockServiceTest;
   void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
+  // Returns the serialized list for |rules|, or nullptr on failure. When
+  // rules were only added, the current |buffer_| is extended instead of
+  // reparsing every rule. |buffer_| itself is left untouched.
+  std::shared_ptr<DATFileData> BuildCustomFiltersData(
+      const std::set<std::string>& rules);
+
+  // The rules serialized in |buffer_|. Only committed once their list was
+  // built or loaded successfully. Only accessed on the task runner.
+  std::set<std::string> custom_rules_;
+  bool custom_rules_loaded_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
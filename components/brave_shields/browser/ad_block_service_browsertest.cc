@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
@@ -11,6 +12,7 @@
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/local_data_files_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -82,9 +84,8 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   }
 
   void AddRulesToAdBlock(const char* rules) {
-    g_brave_browser_process->ad_block_service()
-        ->GetAdBlockClientForTest()
-        ->parse(rules);
+    g_brave_browser_process->ad_block_service()->AddRulesForTest(rules);
+    WaitForDefaultAdBlockServiceThread();
   }
 
   void AssertTagExists(const std::string& tag, bool expected_exists) const {
@@ -215,6 +216,12 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
     ASSERT_TRUE(io_helper->Run());
   }
 
+  void WaitForBlockedEvents() {
+    base::RunLoop run_loop;
+    brave_shields::FlushBlockedEventsFromIOForTesting(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
   void WaitForTrackingProtectionServiceThread() {
     scoped_refptr<base::ThreadTestHelper> io_helper(
         new base::ThreadTestHelper(
@@ -243,6 +250,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByDefaultBlocker) {
                                           "addImage('ad_banner.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -266,6 +274,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                           "addImage('logo.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -287,6 +296,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByCustomBlocker) {
                                           "addImage('ad_banner.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -311,6 +321,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                           "addImage('logo.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -339,6 +350,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByRegionalBlocker) {
                                           "addImage('ad_fr.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -368,6 +380,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                           "addImage('logo.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -402,6 +415,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                           "addImage('v4_specific_banner.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -427,6 +441,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoSameAdsGetCountedAsOne) {
                                           "xhr('adbanner.js')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -451,6 +466,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoDiffAdsGetCountedAsTwo) {
                                           "xhr('adbanner.js?2')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
 }
 
@@ -473,6 +489,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
                                           "xhr('adbanner.js');",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 
   ui_test_utils::NavigateToURL(browser(), url);
@@ -484,6 +501,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
                                           "xhr('adbanner.js');",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
 
   ui_test_utils::NavigateToURL(browser(), url);
@@ -508,6 +526,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrame) {
                                           "xhr('adbanner.js?1');",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 
   // Check also an explicit request for a script since it is a common real-world
@@ -517,6 +536,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrame) {
                             "s.setAttribute('src', 'adbanner.js?2');"
                             "document.head.appendChild(s);"));
   content::RunAllTasksUntilIdle();
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
 }
 
@@ -548,6 +568,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                           "addImage('ad_fr.png')",
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -576,6 +597,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
       test_url.spec().c_str()),
       &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kTrackersBlocked),
       1ULL);
 }
@@ -602,6 +624,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
       test_url.spec().c_str()),
       &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kTrackersBlocked),
       0ULL);
 }
@@ -626,6 +649,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdBlockThirdPartyWorksByETLDP1) {
       resource_url.spec().c_str()),
       &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -649,6 +673,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
       resource_url.spec().c_str()),
       &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -671,6 +696,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, BlockNYP) {
                                             resource_url.spec().c_str()),
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -697,6 +723,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SocialButttonAdBLockTagTest) {
                                             resource_url.spec().c_str()),
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
@@ -722,6 +749,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SocialButttonAdBlockDiffTagTest) {
                                             resource_url.spec().c_str()),
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -792,5 +820,6 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CancelRequestOptionTest) {
                                             resource_url.spec().c_str()),
                                           &as_expected));
   EXPECT_TRUE(as_expected);
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
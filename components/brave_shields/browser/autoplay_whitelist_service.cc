@@ -14,6 +14,7 @@
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
@@ -43,18 +44,21 @@ bool AutoplayWhitelistService::ShouldAllowAutoplay(const GURL& url) {
   return autoplay_whitelist_client_->matchesHost(etld_plus_one.c_str());
 }
 
-void AutoplayWhitelistService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
+void AutoplayWhitelistService::OnDATFileDataReady(
+    std::unique_ptr<DATFileData> buffer) {
+  if (!buffer) {
     LOG(ERROR) << "Could not obtain autoplay whitelist data";
     return;
   }
-  autoplay_whitelist_client_.reset(new AutoplayWhitelistParser());
-  if (!autoplay_whitelist_client_->deserialize(
-        reinterpret_cast<char*>(&buffer_.front()))) {
-    autoplay_whitelist_client_.reset();
+  std::unique_ptr<AutoplayWhitelistParser> client(
+      new AutoplayWhitelistParser());
+  if (!client->deserialize(buffer->data())) {
+    client.reset();
+    buffer.reset();
     LOG(ERROR) << "Failed to deserialize autoplay whitelist data";
-    return;
   }
+  autoplay_whitelist_client_ = std::move(client);
+  buffer_ = std::move(buffer);
 }
 
 void AutoplayWhitelistService::OnComponentReady(
@@ -65,11 +69,11 @@ void AutoplayWhitelistService::OnComponentReady(
   base::FilePath dat_file_path = install_dir.AppendASCII(
     AUTOPLAY_DAT_FILE_VERSION).AppendASCII(AUTOPLAY_DAT_FILE);
 
-  GetTaskRunner()->PostTaskAndReply(
-      FROM_HERE,
-      base::Bind(&GetDATFileData, dat_file_path, &buffer_),
-      base::Bind(&AutoplayWhitelistService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
+  base::PostTaskAndReplyWithResult(
+      GetTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&LoadDATFileData, dat_file_path),
+      base::BindOnce(&AutoplayWhitelistService::OnDATFileDataReady,
+                     weak_factory_.GetWeakPtr()));
 }
 
 scoped_refptr<base::SequencedTaskRunner>
@@ -44,9 +44,11 @@ class AutoplayWhitelistService : public BaseLocalDataFilesObserver {
  private:
   friend class ::BraveContentSettingsObserverAutoplayTest;
 
-  void OnDATFileDataReady();
+  void OnDATFileDataReady(std::unique_ptr<DATFileData> buffer);
 
-  brave_shields::DATFileDataBuffer buffer_;
+  // |autoplay_whitelist_client_| points into |buffer_|, so the two are
+  // always replaced together.
+  std::unique_ptr<DATFileData> buffer_;
 
   std::unique_ptr<AutoplayWhitelistParser> autoplay_whitelist_client_;
 
@@ -0,0 +1,64 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/bloom_filter.h"
+
+#include <algorithm>
+
+namespace brave_shields {
+
+namespace {
+
+const size_t kMinBits = 64;
+const size_t kMaxHashes = 16;
+
+// 64-bit FNV-1a. The two halves are combined into the k probe positions
+// (Kirsch-Mitzenmacher double hashing), so each key is hashed only once.
+uint64_t Hash(base::StringPiece key) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+BloomFilter::BloomFilter(size_t expected_keys, size_t bits_per_key)
+    : num_bits_(std::max(kMinBits, expected_keys * bits_per_key)),
+      // k = ln(2) * m / n minimizes the false positive rate.
+      num_hashes_(std::min(kMaxHashes,
+                           std::max<size_t>(1, bits_per_key * 69 / 100))),
+      bits_((num_bits_ + 63) / 64, 0) {
+}
+
+BloomFilter::~BloomFilter() {
+}
+
+void BloomFilter::Add(base::StringPiece key) {
+  uint64_t hash = Hash(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32);
+  for (size_t i = 0; i < num_hashes_; ++i) {
+    size_t bit = (h1 + i * h2) % num_bits_;
+    bits_[bit / 64] |= 1ULL << (bit % 64);
+  }
+}
+
+bool BloomFilter::MayContain(base::StringPiece key) const {
+  uint64_t hash = Hash(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32);
+  for (size_t i = 0; i < num_hashes_; ++i) {
+    size_t bit = (h1 + i * h2) % num_bits_;
+    if (!(bits_[bit / 64] & (1ULL << (bit % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,42 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOOM_FILTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOOM_FILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// A fixed-size Bloom filter over strings. MayContain() never returns false
+// for a key that was added, and returns true for a key that wasn't added
+// with a probability of roughly 1% at the default of 10 bits per key.
+class BloomFilter {
+ public:
+  explicit BloomFilter(size_t expected_keys, size_t bits_per_key = 10);
+  ~BloomFilter();
+
+  void Add(base::StringPiece key);
+  bool MayContain(base::StringPiece key) const;
+
+  size_t size_in_bytes() const { return bits_.size() * sizeof(uint64_t); }
+
+ private:
+  size_t num_bits_;
+  size_t num_hashes_;
+  std::vector<uint64_t> bits_;
+
+  DISALLOW_COPY_AND_ASSIGN(BloomFilter);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOOM_FILTER_H_
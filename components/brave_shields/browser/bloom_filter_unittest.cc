@@ -0,0 +1,36 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_shields/browser/bloom_filter.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::BloomFilter;
+
+TEST(BloomFilterTest, NoFalseNegatives) {
+  BloomFilter filter(1000);
+  for (int i = 0; i < 1000; ++i) {
+    filter.Add("com.example" + base::NumberToString(i));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(filter.MayContain("com.example" + base::NumberToString(i)));
+  }
+}
+
+TEST(BloomFilterTest, FewFalsePositives) {
+  BloomFilter filter(1000);
+  for (int i = 0; i < 1000; ++i) {
+    filter.Add("com.example" + base::NumberToString(i));
+  }
+  int false_positives = 0;
+  for (int i = 0; i < 10000; ++i) {
+    if (filter.MayContain("org.other" + base::NumberToString(i)))
+      false_positives++;
+  }
+  // The expected rate is about 1%.
+  EXPECT_LT(false_positives, 500);
+}
@@ -4,9 +4,15 @@
 
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 
+#include <utility>
+#include <vector>
+
+#include "base/no_destructor.h"
 #include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/extension_tab_util.h"
@@ -33,6 +39,32 @@ namespace brave_shields {
 
 namespace {
 
+// Blocked events are collected on the IO thread and handed to the UI thread
+// in one task per interval (roughly one frame), instead of one task per
+// blocked request.
+const int kBlockedEventsDispatchIntervalMs = 16;
+
+std::vector<BraveShieldsWebContentsObserver::BlockedEvent>*
+GetPendingBlockedEvents() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  static base::NoDestructor<
+      std::vector<BraveShieldsWebContentsObserver::BlockedEvent>>
+      pending_events;
+  return pending_events.get();
+}
+
+void FlushBlockedEventsOnIO() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  std::vector<BraveShieldsWebContentsObserver::BlockedEvent> events;
+  events.swap(*GetPendingBlockedEvents());
+  if (events.empty()) {
+    return;
+  }
+  base::PostTaskWithTraits(FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvents,
+          std::move(events)));
+}
+
 bool GetDefaultFromResourceIdentifier(const std::string& resource_identifier,
     const GURL& primary_url, const GURL& secondary_url) {
   if (resource_identifier == brave_shields::kAds) {
@@ -76,6 +108,45 @@ bool IsAllowContentSetting(HostContentSettingsMap* content_settings,
 
 }  // namespace
 
+ShieldsSettings GetShieldsSettings(HostContentSettingsMap* content_settings,
+                                   const GURL& tab_origin) {
+  ShieldsSettings settings;
+  if (!content_settings) {
+    return settings;
+  }
+  settings.allow_brave_shields = IsAllowContentSetting(content_settings,
+      tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS, kBraveShields);
+  settings.allow_ads = IsAllowContentSetting(content_settings,
+      tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS, kAds);
+  settings.allow_http_upgradable_resource = IsAllowContentSetting(
+      content_settings, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
+      kHTTPUpgradableResources);
+  settings.allow_1p_cookies = IsAllowContentSetting(content_settings,
+      tab_origin, GURL("https://firstParty/"), CONTENT_SETTINGS_TYPE_PLUGINS,
+      kCookies);
+  settings.allow_3p_cookies = IsAllowContentSetting(content_settings,
+      tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS, kCookies);
+  settings.allow_referrers = IsAllowContentSetting(content_settings,
+      tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS, kReferrers);
+  return settings;
+}
+
+ShieldsSettings GetShieldsSettingsFromIO(const net::URLRequest* request,
+                                         const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  const content::ResourceRequestInfo* resource_info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (!resource_info) {
+    return ShieldsSettings();
+  }
+  ShieldsSettingsCache* cache =
+      ShieldsSettingsCache::FromResourceContext(resource_info->GetContext());
+  if (!cache) {
+    return ShieldsSettings();
+  }
+  return cache->Get(tab_origin);
+}
+
 bool IsAllowContentSettingFromIO(const net::URLRequest* request,
     const GURL& primary_url, const GURL& secondary_url,
     ContentSettingsType setting_type,
@@ -154,10 +225,22 @@ void DispatchBlockedEventFromIO(const GURL &request_url, int render_frame_id,
     int render_process_id, int frame_tree_node_id,
     const std::string& block_type) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  base::PostTaskWithTraits(FROM_HERE, {BrowserThread::UI},
-      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvent,
-          block_type, request_url.spec(),
-          render_process_id, render_frame_id, frame_tree_node_id));
+  std::vector<BraveShieldsWebContentsObserver::BlockedEvent>* pending_events =
+      GetPendingBlockedEvents();
+  // The first event of a batch schedules the flush; later ones ride along.
+  if (pending_events->empty()) {
+    base::PostDelayedTaskWithTraits(FROM_HERE, {BrowserThread::IO},
+        base::BindOnce(&FlushBlockedEventsOnIO),
+        base::TimeDelta::FromMilliseconds(kBlockedEventsDispatchIntervalMs));
+  }
+  pending_events->push_back({block_type, request_url.spec(),
+      render_process_id, render_frame_id, frame_tree_node_id});
+}
+
+void FlushBlockedEventsFromIOForTesting(base::OnceClosure callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  base::PostTaskWithTraitsAndReply(FROM_HERE, {BrowserThread::IO},
+      base::BindOnce(&FlushBlockedEventsOnIO), std::move(callback));
 }
 
 bool ShouldSetReferrer(bool allow_referrers, bool shields_up,
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <string>
 
+#include "base/callback_forward.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 #include "services/network/public/mojom/referrer_policy.mojom.h"
 
@@ -20,11 +21,32 @@ struct Referrer;
 }
 
 class GURL;
+class HostContentSettingsMap;
 class Profile;
 class ProfileIOData;
 
 namespace brave_shields {
 
+// The brave shields settings that apply to every request of a tab.
+struct ShieldsSettings {
+  bool allow_brave_shields = true;
+  bool allow_ads = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_1p_cookies = true;
+  bool allow_3p_cookies = false;
+  bool allow_referrers = false;
+};
+
+// Resolves all shields settings for |tab_origin|. Returns the defaults if
+// |content_settings| is null.
+ShieldsSettings GetShieldsSettings(HostContentSettingsMap* content_settings,
+                                   const GURL& tab_origin);
+
+// Same as above for the profile |request| belongs to, but served from the
+// profile's ShieldsSettingsCache.
+ShieldsSettings GetShieldsSettingsFromIO(const net::URLRequest* request,
+                                         const GURL& tab_origin);
+
 bool IsAllowContentSettingWithIOData(ProfileIOData* io_data,
     const GURL& primary_url, const GURL& secondary_url,
     ContentSettingsType setting_type,
@@ -45,6 +67,10 @@ void DispatchBlockedEventFromIO(const GURL &request_url, int render_frame_id,
     int render_process_id, int frame_tree_node_id,
     const std::string& block_type);
 
+// Hands blocked events still batched on the IO thread to the UI thread now
+// and runs |callback| on the UI thread once they have been dispatched.
+void FlushBlockedEventsFromIOForTesting(base::OnceClosure callback);
+
 void GetRenderFrameInfo(const net::URLRequest* request,
     int* render_frame_id,
     int* render_process_id,
@@ -96,6 +96,21 @@ WebContents* GetWebContents(
   return web_contents;
 }
 
+const char* GetBlockedCountPrefName(const std::string& block_type) {
+  if (block_type == brave_shields::kAds) {
+    return kAdsBlocked;
+  } else if (block_type == brave_shields::kTrackers) {
+    return kTrackersBlocked;
+  } else if (block_type == brave_shields::kHTTPUpgradableResources) {
+    return kHttpsUpgrades;
+  } else if (block_type == brave_shields::kJavaScript) {
+    return kJavascriptBlocked;
+  } else if (block_type == brave_shields::kFingerprinting) {
+    return kFingerprintingBlocked;
+  }
+  return nullptr;
+}
+
 }  // namespace
 
 namespace brave_shields {
@@ -219,42 +234,42 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
 }
 
 // static
-void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
-    std::string block_type,
-    std::string subresource,
-    int render_process_id,
-    int render_frame_id,
-    int frame_tree_node_id) {
+void BraveShieldsWebContentsObserver::DispatchBlockedEvents(
+    std::vector<BlockedEvent> events) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  WebContents* web_contents = GetWebContents(render_process_id,
-    render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  // Stats are summed over the whole batch so that each counter pref is only
+  // written once per profile, rather than once per blocked request.
+  std::map<PrefService*, std::map<std::string, uint64_t>> blocked_counts;
+  for (const BlockedEvent& event : events) {
+    WebContents* web_contents = GetWebContents(event.render_process_id,
+      event.render_frame_id, event.frame_tree_node_id);
+    DispatchBlockedEventForWebContents(event.block_type, event.subresource,
+        web_contents);
+    if (!web_contents) {
+      continue;
+    }
 
-  if (web_contents) {
     BraveShieldsWebContentsObserver* observer =
         BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kTrackers) {
-        prefs->SetUint64(kTrackersBlocked,
-            prefs->GetUint64(kTrackersBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprinting) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
+    if (!observer || observer->IsBlockedSubresource(event.subresource)) {
+      continue;
+    }
+    observer->AddBlockedSubresource(event.subresource);
+    PrefService* prefs = Profile::FromBrowserContext(
+        web_contents->GetBrowserContext())->
+        GetOriginalProfile()->
+        GetPrefs();
+    ++blocked_counts[prefs][event.block_type];
+  }
+
+  for (const auto& prefs_counts : blocked_counts) {
+    PrefService* prefs = prefs_counts.first;
+    for (const auto& block_type_count : prefs_counts.second) {
+      const char* pref_name = GetBlockedCountPrefName(block_type_count.first);
+      if (pref_name) {
+        prefs->SetUint64(pref_name,
+            prefs->GetUint64(pref_name) + block_type_count.second);
       }
     }
   }
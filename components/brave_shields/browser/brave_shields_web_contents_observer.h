@@ -28,6 +28,15 @@ namespace brave_shields {
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
     public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
  public:
+  // A blocked subresource reported from the IO thread.
+  struct BlockedEvent {
+    std::string block_type;
+    std::string subresource;
+    int render_process_id;
+    int render_frame_id;
+    int frame_tree_node_id;
+  };
+
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
   ~BraveShieldsWebContentsObserver() override;
 
@@ -36,11 +45,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       const std::string& block_type,
       const std::string& subresource,
       content::WebContents* web_contents);
-  static void DispatchBlockedEvent(
-      std::string block_type,
-      std::string subresource,
-      int render_process_id,
-      int render_frame_id, int frame_tree_node_id);
+  static void DispatchBlockedEvents(std::vector<BlockedEvent> events);
   static GURL GetTabURLFromRenderFrameInfo(int render_process_id,
                                            int render_frame_id,
                                            int render_frame_tree_node_id);
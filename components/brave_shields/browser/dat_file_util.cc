@@ -4,8 +4,16 @@
 
 #include "brave/components/brave_shields/browser/dat_file_util.h"
 
+#include <utility>
+
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/numerics/safe_conversions.h"
+
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+#endif
 
 namespace brave_shields {
 
@@ -28,4 +36,84 @@ void GetDATFileData(const base::FilePath& file_path,
   }
 }
 
+DATFileData::DATFileData() {
+}
+
+DATFileData::DATFileData(DATFileDataBuffer buffer)
+    : buffer_(std::move(buffer)) {
+}
+
+DATFileData::~DATFileData() {
+#if defined(OS_POSIX)
+  if (mapped_data_) {
+    munmap(mapped_data_, mapped_length_);
+  }
+#endif
+}
+
+bool DATFileData::Load(const base::FilePath& file_path) {
+  if (Map(file_path)) {
+    return true;
+  }
+
+  GetDATFileData(file_path, &buffer_);
+  return !buffer_.empty();
+}
+
+bool DATFileData::Map(const base::FilePath& file_path) {
+#if defined(OS_POSIX)
+  base::File file(file_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
+    return false;
+  }
+
+  int64_t length = file.GetLength();
+  if (length <= 0 || !base::IsValueInRangeForNumericType<size_t>(length)) {
+    return false;
+  }
+
+  // MAP_PRIVATE keeps writes in private pages. The mapping stays valid after
+  // |file| is closed.
+  void* data = mmap(nullptr, static_cast<size_t>(length),
+                    PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    file.GetPlatformFile(), 0);
+  if (data == MAP_FAILED) {
+    LOG(WARNING) << "DATFileData: cannot map dat file " << file_path
+                 << ", reading it instead";
+    return false;
+  }
+
+  mapped_data_ = data;
+  mapped_length_ = static_cast<size_t>(length);
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t DATFileData::size() const {
+  if (mapped_data_) {
+    return mapped_length_;
+  }
+  return buffer_.size();
+}
+
+char* DATFileData::data() const {
+  if (mapped_data_) {
+    return static_cast<char*>(mapped_data_);
+  }
+  if (buffer_.empty()) {
+    return nullptr;
+  }
+  return reinterpret_cast<char*>(const_cast<unsigned char*>(&buffer_.front()));
+}
+
+std::unique_ptr<DATFileData> LoadDATFileData(const base::FilePath& file_path) {
+  auto data = std::make_unique<DATFileData>();
+  if (!data->Load(file_path)) {
+    return nullptr;
+  }
+  return data;
+}
+
 }  // namespace brave_shields
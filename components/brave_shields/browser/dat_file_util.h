@@ -5,9 +5,12 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
 
+#include <memory>
 #include <vector>
 
 #include "base/callback_forward.h"
+#include "base/macros.h"
+#include "build/build_config.h"
 
 namespace base {
 class FilePath;
@@ -20,6 +23,42 @@ using DATFileDataBuffer = std::vector<unsigned char>;
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 
+// The contents of a DAT file. On POSIX the file is mapped private and
+// copy-on-write: pages are shared with the page cache and only faulted in as
+// the parser touches them, and a parser that writes through data() only
+// dirties its own copy of a page. The descriptor is closed right after
+// mapping, so component updates can still remove old versions. On Windows a
+// mapped view would keep the component directory from being deleted, so the
+// file is read into a heap buffer there, as it is whenever mapping fails.
+class DATFileData {
+ public:
+  DATFileData();
+  // Wraps data that is already in memory, such as a freshly serialized list.
+  explicit DATFileData(DATFileDataBuffer buffer);
+  ~DATFileData();
+
+  bool Load(const base::FilePath& file_path);
+
+  bool empty() const { return size() == 0; }
+  size_t size() const;
+  // Writable, since the parsers take a mutable pointer. Parsers that
+  // deserialize from this data keep pointers into it, so it must outlive them.
+  char* data() const;
+  bool is_mapped() const { return mapped_data_ != nullptr; }
+
+ private:
+  bool Map(const base::FilePath& file_path);
+
+  void* mapped_data_ = nullptr;
+  size_t mapped_length_ = 0;
+  DATFileDataBuffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(DATFileData);
+};
+
+// Returns nullptr if the file is missing, empty or unreadable.
+std::unique_ptr<DATFileData> LoadDATFileData(const base::FilePath& file_path);
+
 }  // namespace brave_shields
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
@@ -0,0 +1,66 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::DATFileData;
+using brave_shields::LoadDATFileData;
+
+TEST(DATFileDataTest, WritesDoNotReachTheFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.GetPath().AppendASCII("test.dat");
+  const std::string contents = "dat file contents";
+  ASSERT_EQ(static_cast<int>(contents.size()),
+            base::WriteFile(path, contents.data(), contents.size()));
+
+  std::unique_ptr<DATFileData> data = LoadDATFileData(path);
+  ASSERT_TRUE(data);
+  ASSERT_EQ(contents.size(), data->size());
+  EXPECT_EQ(contents, std::string(data->data(), data->size()));
+
+  data->data()[0] = 'D';
+  EXPECT_EQ('D', data->data()[0]);
+
+  std::string on_disk;
+  ASSERT_TRUE(base::ReadFileToString(path, &on_disk));
+  EXPECT_EQ(contents, on_disk);
+}
+
+TEST(DATFileDataTest, FileCanBeDeletedWhileLoaded) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath dir = temp_dir.GetPath().AppendASCII("1.0.0");
+  ASSERT_TRUE(base::CreateDirectory(dir));
+  base::FilePath path = dir.AppendASCII("test.dat");
+  const std::string contents = "dat file contents";
+  ASSERT_EQ(static_cast<int>(contents.size()),
+            base::WriteFile(path, contents.data(), contents.size()));
+
+  std::unique_ptr<DATFileData> data = LoadDATFileData(path);
+  ASSERT_TRUE(data);
+
+  // Component updates remove the directories of old versions.
+  EXPECT_TRUE(base::DeleteFile(dir, true));
+  EXPECT_FALSE(base::PathExists(dir));
+  EXPECT_EQ(contents, std::string(data->data(), data->size()));
+}
+
+TEST(DATFileDataTest, MissingOrEmptyFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.GetPath().AppendASCII("empty.dat");
+  EXPECT_FALSE(LoadDATFileData(path));
+
+  ASSERT_EQ(0, base::WriteFile(path, "", 0));
+  EXPECT_FALSE(LoadDATFileData(path));
+}
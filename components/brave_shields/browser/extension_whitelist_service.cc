@@ -14,6 +14,7 @@
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
@@ -44,18 +45,21 @@ bool ExtensionWhitelistService::IsBlacklisted(const std::string& extension_id) c
   return extension_whitelist_client_->isBlacklisted(extension_id.c_str());
 }
 
-void ExtensionWhitelistService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
+void ExtensionWhitelistService::OnDATFileDataReady(
+    std::unique_ptr<DATFileData> buffer) {
+  if (!buffer) {
     LOG(ERROR) << "Could not obtain extension whitelist data";
     return;
   }
-  extension_whitelist_client_.reset(new ExtensionWhitelistParser());
-  if (!extension_whitelist_client_->deserialize(
-        reinterpret_cast<char*>(&buffer_.front()))) {
-    extension_whitelist_client_.reset();
+  std::unique_ptr<ExtensionWhitelistParser> client(
+      new ExtensionWhitelistParser());
+  if (!client->deserialize(buffer->data())) {
+    client.reset();
+    buffer.reset();
     LOG(ERROR) << "Failed to deserialize extension whitelist data";
-    return;
   }
+  extension_whitelist_client_ = std::move(client);
+  buffer_ = std::move(buffer);
 }
 
 void ExtensionWhitelistService::OnComponentReady(
@@ -66,11 +70,11 @@ void ExtensionWhitelistService::OnComponentReady(
   base::FilePath dat_file_path = install_dir.AppendASCII(
     EXTENSION_DAT_FILE_VERSION).AppendASCII(EXTENSION_DAT_FILE);
 
-  GetTaskRunner()->PostTaskAndReply(
-      FROM_HERE,
-      base::Bind(&GetDATFileData, dat_file_path, &buffer_),
-      base::Bind(&ExtensionWhitelistService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
+  base::PostTaskAndReplyWithResult(
+      GetTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&LoadDATFileData, dat_file_path),
+      base::BindOnce(&ExtensionWhitelistService::OnDATFileDataReady,
+                     weak_factory_.GetWeakPtr()));
 }
 
 scoped_refptr<base::SequencedTaskRunner>
@@ -47,9 +47,11 @@ class ExtensionWhitelistService : public BaseLocalDataFilesObserver {
   friend class ::BraveExtensionProviderTest;
   friend class ::BravePDFDownloadTest;
 
-  void OnDATFileDataReady();
+  void OnDATFileDataReady(std::unique_ptr<DATFileData> buffer);
 
-  brave_shields::DATFileDataBuffer buffer_;
+  // |extension_whitelist_client_| points into |buffer_|, so the two are
+  // always replaced together.
+  std::unique_ptr<DATFileData> buffer_;
 
   std::unique_ptr<ExtensionWhitelistParser> extension_whitelist_client_;
 
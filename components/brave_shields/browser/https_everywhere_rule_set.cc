@@ -0,0 +1,166 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Rough per-instruction cost of a compiled RE2 program.
+const size_t kRE2BytesPerInstruction = 16;
+
+size_t EstimateRE2MemoryUsage(const re2::RE2& re) {
+  return sizeof(re2::RE2) + re.pattern().capacity() +
+         re.ProgramSize() * kRE2BytesPerInstruction;
+}
+
+std::unique_ptr<re2::RE2> CompileRE2(const std::string& pattern) {
+  auto re = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+  if (!re->ok()) {
+    return nullptr;
+  }
+  return re;
+}
+
+}  // namespace
+
+std::string CorrecttoRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+HTTPSERuleSet::Rule::Rule() = default;
+HTTPSERuleSet::Rule::Rule(Rule&& other) = default;
+HTTPSERuleSet::Rule::~Rule() = default;
+
+HTTPSERuleSet::Target::Target() = default;
+HTTPSERuleSet::Target::Target(Target&& other) = default;
+HTTPSERuleSet::Target::~Target() = default;
+
+HTTPSERuleSet::HTTPSERuleSet() = default;
+HTTPSERuleSet::~HTTPSERuleSet() = default;
+
+// static
+std::unique_ptr<HTTPSERuleSet> HTTPSERuleSet::Parse(const std::string& json) {
+  std::unique_ptr<base::Value> json_object = base::JSONReader::Read(json);
+  const base::ListValue* top_values = nullptr;
+  if (!json_object || !json_object->GetAsList(&top_values)) {
+    return nullptr;
+  }
+
+  std::unique_ptr<HTTPSERuleSet> rule_set(new HTTPSERuleSet());
+  rule_set->memory_usage_ = sizeof(HTTPSERuleSet);
+  for (size_t i = 0; i < top_values->GetSize(); ++i) {
+    const base::DictionaryValue* target_dictionary = nullptr;
+    if (!top_values->GetDictionary(i, &target_dictionary)) {
+      continue;
+    }
+
+    Target target;
+    const base::ListValue* exclusions = nullptr;
+    if (target_dictionary->GetList("e", &exclusions)) {
+      for (size_t j = 0; j < exclusions->GetSize(); ++j) {
+        const base::DictionaryValue* exclusion = nullptr;
+        std::string pattern;
+        if (!exclusions->GetDictionary(j, &exclusion) ||
+            !exclusion->GetString("p", &pattern)) {
+          continue;
+        }
+        auto re = CompileRE2(CorrecttoRuleToRE2Engine(pattern));
+        if (re) {
+          rule_set->memory_usage_ += EstimateRE2MemoryUsage(*re);
+          target.exclusions.push_back(std::move(re));
+        }
+      }
+    }
+
+    const base::ListValue* rules = nullptr;
+    target.has_rules = target_dictionary->GetList("r", &rules);
+    if (target.has_rules) {
+      for (size_t j = 0; j < rules->GetSize(); ++j) {
+        const base::DictionaryValue* rule_dictionary = nullptr;
+        if (!rules->GetDictionary(j, &rule_dictionary)) {
+          continue;
+        }
+        Rule rule;
+        if (rule_dictionary->HasKey("d")) {
+          rule.is_default = true;
+          target.rules.push_back(std::move(rule));
+          // Nothing after a default rule can ever be reached.
+          break;
+        }
+        std::string from;
+        std::string to;
+        if (!rule_dictionary->GetString("f", &from) ||
+            !rule_dictionary->GetString("t", &to)) {
+          continue;
+        }
+        rule.from = CompileRE2(from);
+        if (!rule.from) {
+          continue;
+        }
+        rule.to = CorrecttoRuleToRE2Engine(to);
+        rule_set->memory_usage_ +=
+            EstimateRE2MemoryUsage(*rule.from) + rule.to.capacity();
+        target.rules.push_back(std::move(rule));
+      }
+    }
+
+    rule_set->memory_usage_ += sizeof(Target) +
+        target.exclusions.capacity() * sizeof(std::unique_ptr<re2::RE2>) +
+        target.rules.capacity() * sizeof(Rule);
+    bool has_rules = target.has_rules;
+    rule_set->targets_.push_back(std::move(target));
+    // Lookups never get past a target without rules.
+    if (!has_rules) {
+      break;
+    }
+  }
+
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& original_url) const {
+  for (const Target& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (re2::RE2::FullMatch(original_url, *exclusion)) {
+        return "";
+      }
+    }
+
+    if (!target.has_rules) {
+      return "";
+    }
+
+    for (const Rule& rule : target.rules) {
+      if (rule.is_default) {
+        std::string new_url(original_url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(original_url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != original_url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
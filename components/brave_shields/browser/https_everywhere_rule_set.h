@@ -0,0 +1,72 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace re2 {
+class RE2;
+}
+
+namespace brave_shields {
+
+// Converts the $1-style back references used by HTTPS Everywhere rules to
+// the \1 form understood by RE2.
+std::string CorrecttoRuleToRE2Engine(const std::string& to);
+
+// The compiled form of the JSON ruleset stored under one leveldb key. All
+// regular expressions are built once when the ruleset is parsed, so applying
+// it to a URL doesn't touch the JSON or construct any RE2 objects.
+class HTTPSERuleSet {
+ public:
+  ~HTTPSERuleSet();
+
+  // Returns nullptr if |json| isn't a list of rulesets.
+  static std::unique_ptr<HTTPSERuleSet> Parse(const std::string& json);
+
+  // Returns the upgraded URL, or an empty string if no rule applies.
+  std::string Apply(const std::string& original_url) const;
+
+  // Approximate heap footprint, used to bound the compiled ruleset cache.
+  size_t EstimateMemoryUsage() const { return memory_usage_; }
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(Rule&& other);
+    ~Rule();
+    // The "d" (default) rule only swaps http for https.
+    bool is_default = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Target {
+    Target();
+    Target(Target&& other);
+    ~Target();
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // Targets without a valid "r" list end the lookup with no match.
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERuleSet();
+
+  std::vector<Target> targets_;
+  size_t memory_usage_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
@@ -0,0 +1,62 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERuleSet;
+
+TEST(HTTPSERuleSetTest, InvalidJSON) {
+  EXPECT_FALSE(HTTPSERuleSet::Parse("not json"));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{\"r\": []}"));
+}
+
+TEST(HTTPSERuleSetTest, DefaultRule) {
+  auto rule_set = HTTPSERuleSet::Parse("[{\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/"), "https://example.com/");
+}
+
+TEST(HTTPSERuleSetTest, RewriteRule) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      "[{\"r\": [{\"f\": \"^http://(www\\\\.)?example\\\\.com/\","
+      "           \"t\": \"https://secure.example.com/\"}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://www.example.com/a"),
+            "https://secure.example.com/a");
+  EXPECT_EQ(rule_set->Apply("http://example.org/a"), "");
+  // Applying the same compiled rules again gives the same result.
+  EXPECT_EQ(rule_set->Apply("http://example.com/b"),
+            "https://secure.example.com/b");
+  EXPECT_GT(rule_set->EstimateMemoryUsage(), 0u);
+}
+
+TEST(HTTPSERuleSetTest, BackReferences) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      "[{\"r\": [{\"f\": \"^http://([^/]+)\\\\.example\\\\.com/\","
+      "           \"t\": \"https://$1.example.com/\"}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://foo.example.com/"),
+            "https://foo.example.com/");
+}
+
+TEST(HTTPSERuleSetTest, Exclusions) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      "[{\"e\": [{\"p\": \"^http://example\\\\.com/plain.*\"}],"
+      "  \"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/plain/page"), "");
+  EXPECT_EQ(rule_set->Apply("http://example.com/other"),
+            "https://example.com/other");
+}
+
+TEST(HTTPSERuleSetTest, TargetWithoutRulesStopsLookup) {
+  auto rule_set = HTTPSERuleSet::Parse("[{}, {\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/"), "");
+}
@@ -11,23 +11,25 @@
 #include <vector>
 
 #include "base/base_paths.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/bloom_filter.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 #include "chrome/browser/browser_process.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
+#include "third_party/leveldatabase/src/include/leveldb/iterator.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
 #define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_RULE_SET_CACHE_MAX_BYTES     (2 * 1024 * 1024)
 
 namespace {
 
@@ -87,7 +89,12 @@ std::string
 HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
     kHTTPSEverywhereComponentBase64PublicKey);
 
-HTTPSEverywhereService::HTTPSEverywhereService() : level_db_(nullptr) {
+HTTPSEverywhereService::HTTPSEverywhereService()
+    : level_db_(nullptr),
+      rule_set_cache_(
+          base::MRUCache<std::string,
+                         std::unique_ptr<HTTPSERuleSet>>::NO_AUTO_EVICT),
+      rule_set_cache_memory_usage_(0) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -135,6 +142,61 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
     CloseDatabase();
     return;
   }
+
+  BuildHostFilter();
+}
+
+void HTTPSEverywhereService::BuildHostFilter() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::vector<std::string> keys;
+  std::unique_ptr<leveldb::Iterator> it(
+      level_db_->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    keys.push_back(it->key().ToString());
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPS Everywhere keys, error: "
+               << it->status().ToString();
+    return;
+  }
+
+  host_filter_ = std::make_unique<BloomFilter>(keys.size());
+  for (const std::string& key : keys) {
+    host_filter_->Add(key);
+  }
+}
+
+const HTTPSERuleSet* HTTPSEverywhereService::GetRuleSet(
+    const std::string& key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (host_filter_ && !host_filter_->MayContain(key)) {
+    return nullptr;
+  }
+
+  auto cached = rule_set_cache_.Get(key);
+  if (cached != rule_set_cache_.end()) {
+    return cached->second.get();
+  }
+
+  std::string value = leveldbGet(level_db_, key);
+  // Keys without a value are cached too so bloom filter false positives
+  // only cost one leveldb lookup.
+  std::unique_ptr<HTTPSERuleSet> rule_set;
+  if (!value.empty()) {
+    rule_set = HTTPSERuleSet::Parse(value);
+  }
+  size_t memory_usage =
+      key.capacity() + (rule_set ? rule_set->EstimateMemoryUsage() : 0);
+  while (!rule_set_cache_.empty() &&
+         rule_set_cache_memory_usage_ + memory_usage >
+             HTTPSE_RULE_SET_CACHE_MAX_BYTES) {
+    auto oldest = rule_set_cache_.rbegin();
+    rule_set_cache_memory_usage_ -= oldest->first.capacity() +
+        (oldest->second ? oldest->second->EstimateMemoryUsage() : 0);
+    rule_set_cache_.Erase(oldest);
+  }
+  rule_set_cache_memory_usage_ += memory_usage;
+  return rule_set_cache_.Put(key, std::move(rule_set))->second.get();
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -177,10 +239,10 @@ bool HTTPSEverywhereService::GetHTTPSURL(
 
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      new_url = ApplyHTTPSRule(candidate_url.spec(), value);
+  for (const auto& domain : domains) {
+    const HTTPSERuleSet* rule_set = GetRuleSet(domain);
+    if (rule_set) {
+      new_url = rule_set->Apply(candidate_url.spec());
       if (0 != new_url.length()) {
         recently_used_cache_.add(candidate_url.spec(), new_url);
         AddHTTPSEUrlToRedirectList(request_identifier);
@@ -255,126 +317,11 @@ void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
   }
 }
 
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  std::unique_ptr<base::Value> json_object = base::JSONReader::Read(rule);
-  if (nullptr == json_object.get()) {
-    return "";
-  }
-
-  const base::ListValue* topValues = nullptr;
-  json_object->GetAsList(&topValues);
-  if (nullptr == topValues) {
-    return "";
-  }
-
-  for (size_t i = 0; i < topValues->GetSize(); ++i) {
-    const base::Value* childTopValue = nullptr;
-    if (!topValues->Get(i, &childTopValue)) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    childTopValue->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
-
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  host_filter_.reset();
+  rule_set_cache_.Clear();
+  rule_set_cache_memory_usage_ = 0;
   if (level_db_) {
     delete level_db_;
     level_db_ = nullptr;
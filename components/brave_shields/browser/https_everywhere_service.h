@@ -12,6 +12,7 @@
 #include <vector>
 #include <mutex>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
@@ -26,6 +27,9 @@ class HTTPSEverywhereServiceTest;
 
 namespace brave_shields {
 
+class BloomFilter;
+class HTTPSERuleSet;
+
 const std::string kHTTPSEverywhereComponentName("Brave HTTPS Everywhere Updater");
 const std::string kHTTPSEverywhereComponentId("oofiananboodjbbmdelgdommihjbkfag");
 
@@ -68,9 +72,10 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled ruleset stored under |key|, or nullptr if there is
+  // none. Rulesets are compiled on first use and kept in a memory-bounded
+  // MRU cache.
+  const HTTPSERuleSet* GetRuleSet(const std::string& key);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -85,12 +90,19 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
+  void BuildHostFilter();
 
   std::mutex httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
   leveldb::DB* level_db_;
 
+  // Only accessed on the task runner. |host_filter_| holds every leveldb
+  // key, so hosts without rules are rejected without touching leveldb.
+  std::unique_ptr<BloomFilter> host_filter_;
+  base::MRUCache<std::string, std::unique_ptr<HTTPSERuleSet>> rule_set_cache_;
+  size_t rule_set_cache_memory_usage_;
+
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
 };
@@ -0,0 +1,114 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_MATCHER_POOL_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_MATCHER_POOL_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/system/sys_info.h"
+
+namespace brave_shields {
+
+// The most matchers built for one list. Every matcher is a full copy of the
+// list's lookup tables, so this bounds the memory a list can take.
+const size_t kMaximumMatchersPerList = 4;
+
+// How many matchers to build for one list on this machine.
+inline size_t GetMatcherPoolSize() {
+  return std::max<size_t>(1, std::min<size_t>(
+      base::SysInfo::NumberOfProcessors(), kMaximumMatchersPerList));
+}
+
+// A fixed set of interchangeable matchers built from the same list data.
+// Matching writes to per-matcher state such as stats and bloom filter
+// counters, so a matcher is only used by one caller at a time. Callers take
+// whichever matcher is free, which lets up to size() lookups on one list run
+// in parallel. The pool is built on the list's task runner and published and
+// swapped as a whole, so its matchers never change once it is shared.
+template <typename T>
+class MatcherPool {
+ public:
+  // Holds one matcher of the pool until it goes out of scope.
+  class ScopedMatcher {
+   public:
+    ScopedMatcher(base::Lock* lock, T* matcher)
+        : lock_(lock), matcher_(matcher) {}
+    ScopedMatcher(ScopedMatcher&& other)
+        : lock_(other.lock_), matcher_(other.matcher_) {
+      other.lock_ = nullptr;
+      other.matcher_ = nullptr;
+    }
+    ~ScopedMatcher() {
+      if (lock_)
+        lock_->Release();
+    }
+
+    T* get() const { return matcher_; }
+    T* operator->() const { return matcher_; }
+
+   private:
+    base::Lock* lock_;
+    T* matcher_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedMatcher);
+  };
+
+  explicit MatcherPool(std::vector<std::unique_ptr<T>> matchers)
+      : next_(0) {
+    DCHECK(!matchers.empty());
+    for (auto& matcher : matchers)
+      entries_.push_back(std::make_unique<Entry>(std::move(matcher)));
+  }
+  ~MatcherPool() {}
+
+  // Returns a free matcher, or waits for one if they are all in use.
+  ScopedMatcher Acquire() {
+    const size_t start =
+        next_.fetch_add(1, std::memory_order_relaxed) % entries_.size();
+    for (size_t i = 0; i < entries_.size(); i++) {
+      Entry* entry = entries_[(start + i) % entries_.size()].get();
+      if (entry->lock.Try())
+        return ScopedMatcher(&entry->lock, entry->matcher.get());
+    }
+
+    Entry* entry = entries_[start].get();
+    entry->lock.Acquire();
+    return ScopedMatcher(&entry->lock, entry->matcher.get());
+  }
+
+  // Only for reading state that every matcher shares, such as the enabled
+  // tags. Matching must go through Acquire().
+  T* front() const { return entries_.front()->matcher.get(); }
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    explicit Entry(std::unique_ptr<T> matcher)
+        : matcher(std::move(matcher)) {}
+
+    base::Lock lock;
+    std::unique_ptr<T> matcher;
+  };
+
+  std::vector<std::unique_ptr<Entry>> entries_;
+  std::atomic<size_t> next_;
+
+  DISALLOW_COPY_AND_ASSIGN(MatcherPool);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_MATCHER_POOL_H_
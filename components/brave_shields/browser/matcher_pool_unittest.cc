@@ -0,0 +1,70 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "brave/components/brave_shields/browser/matcher_pool.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::MatcherPool;
+
+namespace {
+
+struct TestMatcher {
+  explicit TestMatcher(int id) : id(id) {}
+
+  int id;
+};
+
+std::unique_ptr<MatcherPool<TestMatcher>> CreatePool(int size) {
+  std::vector<std::unique_ptr<TestMatcher>> matchers;
+  for (int i = 0; i < size; i++)
+    matchers.push_back(std::make_unique<TestMatcher>(i));
+  return std::make_unique<MatcherPool<TestMatcher>>(std::move(matchers));
+}
+
+}  // namespace
+
+TEST(MatcherPoolTest, ConcurrentLookupsGetDifferentMatchers) {
+  std::unique_ptr<MatcherPool<TestMatcher>> pool = CreatePool(3);
+  EXPECT_EQ(3u, pool->size());
+
+  std::vector<MatcherPool<TestMatcher>::ScopedMatcher> held;
+  std::set<int> ids;
+  for (int i = 0; i < 3; i++) {
+    held.push_back(pool->Acquire());
+    ids.insert(held.back()->id);
+  }
+
+  EXPECT_EQ(3u, ids.size());
+}
+
+TEST(MatcherPoolTest, ReleasedMatcherIsReused) {
+  std::unique_ptr<MatcherPool<TestMatcher>> pool = CreatePool(2);
+
+  MatcherPool<TestMatcher>::ScopedMatcher held = pool->Acquire();
+  for (int i = 0; i < 4; i++) {
+    MatcherPool<TestMatcher>::ScopedMatcher matcher = pool->Acquire();
+    EXPECT_NE(held->id, matcher->id);
+  }
+}
+
+TEST(MatcherPoolTest, SingleMatcher) {
+  std::unique_ptr<MatcherPool<TestMatcher>> pool = CreatePool(1);
+
+  for (int i = 0; i < 3; i++) {
+    MatcherPool<TestMatcher>::ScopedMatcher matcher = pool->Acquire();
+    EXPECT_EQ(pool->front(), matcher.get());
+  }
+}
+
+TEST(MatcherPoolTest, PoolSizeIsBounded) {
+  EXPECT_GE(brave_shields::GetMatcherPoolSize(), 1u);
+  EXPECT_LE(brave_shields::GetMatcherPoolSize(),
+            brave_shields::kMaximumMatchersPerList);
+}
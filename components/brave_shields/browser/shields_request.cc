@@ -0,0 +1,39 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_request.h"
+
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace brave_shields {
+
+namespace {
+
+bool IsThirdParty(const GURL& url, const std::string& tab_host) {
+  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+  // a URL or origin and not a string to a host name.
+  return !SameDomainOrHost(url, url::Origin::CreateFromNormalizedTuple(
+      "https", tab_host.c_str(), 80), INCLUDE_PRIVATE_REGISTRIES);
+}
+
+}  // namespace
+
+ShieldsRequest::ShieldsRequest(const GURL& url,
+                               content::ResourceType resource_type,
+                               const std::string& tab_host)
+    : spec(url.spec()),
+      host(url.host()),
+      tab_host(tab_host),
+      resource_type(resource_type),
+      is_third_party(IsThirdParty(url, tab_host)) {
+}
+
+ShieldsRequest::~ShieldsRequest() = default;
+
+}  // namespace brave_shields
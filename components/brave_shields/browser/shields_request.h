@@ -0,0 +1,38 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_REQUEST_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_REQUEST_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "content/public/common/resource_type.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// A request as seen by the ad-block and tracking protection matchers. It is
+// normalized once, so checking it against several lists doesn't recompute
+// the spec, the host or whether the request is third-party for each list.
+struct ShieldsRequest {
+  ShieldsRequest(const GURL& url,
+                 content::ResourceType resource_type,
+                 const std::string& tab_host);
+  ~ShieldsRequest();
+
+  const std::string spec;
+  const std::string host;
+  const std::string tab_host;
+  const content::ResourceType resource_type;
+  const bool is_third_party;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsRequest);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_REQUEST_H_
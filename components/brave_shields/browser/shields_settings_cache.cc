@@ -0,0 +1,136 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/task/post_task.h"
+#include "chrome/browser/profiles/profile_io_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/resource_context.h"
+
+using content::BrowserThread;
+
+namespace brave_shields {
+
+namespace {
+
+const char kShieldsSettingsCacheKey[] = "brave_shields_settings_cache";
+const size_t kShieldsSettingsCacheSize = 100;
+
+}  // namespace
+
+// Registered with the content settings map on the UI thread. Bumps the
+// generation so the IO thread cache drops everything on its next lookup.
+class ShieldsSettingsCache::Observer
+    : public content_settings::Observer,
+      public base::RefCountedThreadSafe<ShieldsSettingsCache::Observer> {
+ public:
+  Observer() : generation_(0) {}
+
+  void AddToContentSettings(
+      scoped_refptr<HostContentSettingsMap> content_settings) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    content_settings->AddObserver(this);
+    // Settings resolved before the observer was registered may be stale.
+    generation_++;
+  }
+
+  void RemoveFromContentSettings(
+      scoped_refptr<HostContentSettingsMap> content_settings) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    content_settings->RemoveObserver(this);
+  }
+
+  int generation() const { return generation_.load(); }
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(
+      const ContentSettingsPattern& primary_pattern,
+      const ContentSettingsPattern& secondary_pattern,
+      ContentSettingsType content_type,
+      const std::string& resource_identifier) override {
+    if (content_type == CONTENT_SETTINGS_TYPE_PLUGINS ||
+        content_type == CONTENT_SETTINGS_TYPE_DEFAULT) {
+      generation_++;
+    }
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Observer>;
+  ~Observer() override {}
+
+  std::atomic<int> generation_;
+
+  DISALLOW_COPY_AND_ASSIGN(Observer);
+};
+
+ShieldsSettingsCache::ShieldsSettingsCache(
+    HostContentSettingsMap* content_settings)
+    : content_settings_(content_settings),
+      observer_(new Observer()),
+      generation_(0),
+      settings_(kShieldsSettingsCacheSize) {
+  base::PostTaskWithTraits(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&Observer::AddToContentSettings, observer_,
+                     content_settings_));
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() {
+  base::PostTaskWithTraits(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&Observer::RemoveFromContentSettings, observer_,
+                     content_settings_));
+}
+
+// static
+ShieldsSettingsCache* ShieldsSettingsCache::FromResourceContext(
+    content::ResourceContext* context) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (!context) {
+    return nullptr;
+  }
+  auto* cache = static_cast<ShieldsSettingsCache*>(
+      context->GetUserData(kShieldsSettingsCacheKey));
+  if (cache) {
+    return cache;
+  }
+  ProfileIOData* io_data = ProfileIOData::FromResourceContext(context);
+  if (!io_data || !io_data->GetHostContentSettingsMap()) {
+    return nullptr;
+  }
+  cache = new ShieldsSettingsCache(io_data->GetHostContentSettingsMap());
+  context->SetUserData(kShieldsSettingsCacheKey, base::WrapUnique(cache));
+  return cache;
+}
+
+ShieldsSettings ShieldsSettingsCache::Get(const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  int generation = observer_->generation();
+  if (generation != generation_) {
+    settings_.Clear();
+    generation_ = generation;
+  }
+
+  auto it = settings_.Get(tab_origin);
+  if (it != settings_.end()) {
+    return it->second;
+  }
+  ShieldsSettings settings =
+      GetShieldsSettings(content_settings_.get(), tab_origin);
+  settings_.Put(tab_origin, settings);
+  return settings;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,54 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/supports_user_data.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace content {
+class ResourceContext;
+}
+
+namespace brave_shields {
+
+// Caches the resolved brave shields settings of recently used tab origins
+// for one profile, so the network delegate helpers don't walk the content
+// settings map several times for every request. Lookups happen on the IO
+// thread; the whole cache is flushed whenever a plugins content setting
+// (where all shields settings live) changes.
+class ShieldsSettingsCache : public base::SupportsUserData::Data {
+ public:
+  explicit ShieldsSettingsCache(HostContentSettingsMap* content_settings);
+  ~ShieldsSettingsCache() override;
+
+  // Returns the cache attached to |context|, creating it if needed. Returns
+  // nullptr if the context has no content settings.
+  static ShieldsSettingsCache* FromResourceContext(
+      content::ResourceContext* context);
+
+  ShieldsSettings Get(const GURL& tab_origin);
+
+ private:
+  class Observer;
+
+  scoped_refptr<HostContentSettingsMap> content_settings_;
+  scoped_refptr<Observer> observer_;
+  int generation_;
+  base::MRUCache<GURL, ShieldsSettings> settings_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
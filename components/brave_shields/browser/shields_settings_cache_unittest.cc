@@ -0,0 +1,114 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::ShieldsSettings;
+using brave_shields::ShieldsSettingsCache;
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsCacheTest() {}
+  ~ShieldsSettingsCacheTest() override {}
+
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+  }
+
+  void TearDown() override {
+    // Let the cache unregister its observer before the profile goes away.
+    base::RunLoop().RunUntilIdle();
+    profile_.reset();
+  }
+
+  HostContentSettingsMap* content_settings() {
+    return HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+ private:
+  content::TestBrowserThreadBundle thread_bundle_;
+  std::unique_ptr<TestingProfile> profile_;
+};
+
+TEST_F(ShieldsSettingsCacheTest, Defaults) {
+  ShieldsSettingsCache cache(content_settings());
+  ShieldsSettings settings = cache.Get(GURL("https://brave.com/"));
+  EXPECT_TRUE(settings.allow_brave_shields);
+  EXPECT_FALSE(settings.allow_ads);
+  EXPECT_FALSE(settings.allow_http_upgradable_resource);
+  EXPECT_TRUE(settings.allow_1p_cookies);
+  EXPECT_FALSE(settings.allow_3p_cookies);
+  EXPECT_FALSE(settings.allow_referrers);
+}
+
+TEST_F(ShieldsSettingsCacheTest, InvalidatedOnContentSettingChange) {
+  GURL tab_origin("https://brave.com/");
+  auto cache = std::make_unique<ShieldsSettingsCache>(content_settings());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(cache->Get(tab_origin).allow_ads);
+
+  content_settings()->SetContentSettingCustomScope(
+      ContentSettingsPattern::FromURL(tab_origin),
+      ContentSettingsPattern::Wildcard(), CONTENT_SETTINGS_TYPE_PLUGINS,
+      brave_shields::kAds, CONTENT_SETTING_ALLOW);
+  EXPECT_TRUE(cache->Get(tab_origin).allow_ads);
+  EXPECT_FALSE(cache->Get(GURL("https://example.com/")).allow_ads);
+
+  cache.reset();
+}
+
+// Run with --gtest_also_run_disabled_tests to compare cached lookups with
+// resolving the settings from the content settings map for every request.
+TEST_F(ShieldsSettingsCacheTest, DISABLED_Benchmark) {
+  const int kOrigins = 20;
+  const int kRequests = 100000;
+  for (int i = 0; i < kOrigins; i += 2) {
+    content_settings()->SetContentSettingCustomScope(
+        ContentSettingsPattern::FromURL(
+            GURL("https://site" + std::to_string(i) + ".com/")),
+        ContentSettingsPattern::Wildcard(), CONTENT_SETTINGS_TYPE_PLUGINS,
+        brave_shields::kAds, CONTENT_SETTING_ALLOW);
+  }
+  std::vector<GURL> tab_origins;
+  for (int i = 0; i < kOrigins; i++) {
+    tab_origins.push_back(GURL("https://site" + std::to_string(i) + ".com/"));
+  }
+
+  int allowed = 0;
+  base::ElapsedTimer uncached_timer;
+  for (int i = 0; i < kRequests; i++) {
+    allowed += brave_shields::GetShieldsSettings(
+        content_settings(), tab_origins[i % kOrigins]).allow_ads;
+  }
+  base::TimeDelta uncached = uncached_timer.Elapsed();
+
+  auto cache = std::make_unique<ShieldsSettingsCache>(content_settings());
+  base::RunLoop().RunUntilIdle();
+  int cached_allowed = 0;
+  base::ElapsedTimer cached_timer;
+  for (int i = 0; i < kRequests; i++) {
+    cached_allowed += cache->Get(tab_origins[i % kOrigins]).allow_ads;
+  }
+  base::TimeDelta cached = cached_timer.Elapsed();
+  cache.reset();
+
+  EXPECT_EQ(allowed, cached_allowed);
+  LOG(INFO) << kRequests << " lookups: " << uncached.InMilliseconds()
+      << "ms uncached, " << cached.InMilliseconds() << "ms cached";
+}
@@ -0,0 +1,106 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/third_party_hosts_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "base/strings/string_split.h"
+
+namespace brave_shields {
+
+namespace {
+
+const size_t kNumShards = 8;
+
+}  // namespace
+
+HostSuffixSet::HostSuffixSet(const std::vector<std::string>& hosts)
+    : hosts_(hosts.begin(), hosts.end()) {
+}
+
+HostSuffixSet::~HostSuffixSet() = default;
+
+// static
+std::unique_ptr<HostSuffixSet> HostSuffixSet::FromCommaSeparatedList(
+    const std::string& hosts) {
+  return std::make_unique<HostSuffixSet>(base::SplitString(
+      hosts, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY));
+}
+
+bool HostSuffixSet::Matches(const std::string& host) const {
+  if (hosts_.empty()) {
+    return false;
+  }
+  size_t pos = 0;
+  while (pos < host.length()) {
+    if (hosts_.count(pos == 0 ? host : host.substr(pos))) {
+      return true;
+    }
+    size_t dot = host.find('.', pos);
+    if (dot == std::string::npos) {
+      break;
+    }
+    pos = dot + 1;
+  }
+  return false;
+}
+
+ThirdPartyHostsCache::Shard::Shard(size_t max_entries)
+    : entries(max_entries) {
+}
+
+ThirdPartyHostsCache::Shard::~Shard() = default;
+
+ThirdPartyHostsCache::ThirdPartyHostsCache(size_t max_entries) {
+  size_t max_entries_per_shard =
+      std::max<size_t>(1, (max_entries + kNumShards - 1) / kNumShards);
+  for (size_t i = 0; i < kNumShards; ++i) {
+    shards_.push_back(std::make_unique<Shard>(max_entries_per_shard));
+  }
+}
+
+ThirdPartyHostsCache::~ThirdPartyHostsCache() = default;
+
+std::shared_ptr<const HostSuffixSet> ThirdPartyHostsCache::Get(
+    const std::string& tab_host,
+    uint64_t generation) {
+  Shard* shard = GetShard(tab_host);
+  base::AutoLock lock(shard->lock);
+  auto it = shard->entries.Get(tab_host);
+  if (it == shard->entries.end() || it->second.first != generation) {
+    return nullptr;
+  }
+  return it->second.second;
+}
+
+void ThirdPartyHostsCache::Put(const std::string& tab_host,
+                               uint64_t generation,
+                               std::shared_ptr<const HostSuffixSet> hosts) {
+  Shard* shard = GetShard(tab_host);
+  base::AutoLock lock(shard->lock);
+  auto it = shard->entries.Peek(tab_host);
+  if (it != shard->entries.end() && it->second.first > generation) {
+    // Don't let a lookup against an old parser replace a current entry.
+    return;
+  }
+  shard->entries.Put(tab_host, Entry(generation, std::move(hosts)));
+}
+
+void ThirdPartyHostsCache::Clear() {
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard->lock);
+    shard->entries.Clear();
+  }
+}
+
+ThirdPartyHostsCache::Shard* ThirdPartyHostsCache::GetShard(
+    const std::string& tab_host) {
+  return shards_[std::hash<std::string>()(tab_host) % shards_.size()].get();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,88 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_THIRD_PARTY_HOSTS_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_THIRD_PARTY_HOSTS_CACHE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// The hosts that a first party is allowed to load trackers from, parsed once
+// so that a lookup only hashes each parent domain of the request host.
+class HostSuffixSet {
+ public:
+  explicit HostSuffixSet(const std::vector<std::string>& hosts);
+  ~HostSuffixSet();
+
+  // Parses the comma-separated list returned by the tracking protection
+  // parser.
+  static std::unique_ptr<HostSuffixSet> FromCommaSeparatedList(
+      const std::string& hosts);
+
+  // Returns true if |host| is one of the hosts or a subdomain of one.
+  bool Matches(const std::string& host) const;
+
+  bool empty() const { return hosts_.empty(); }
+  size_t size() const { return hosts_.size(); }
+
+ private:
+  std::unordered_set<std::string> hosts_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostSuffixSet);
+};
+
+// A thread-safe LRU cache from a tab host to its third-party host set. The
+// entries are spread over independently locked shards so that lookups from
+// concurrent requests rarely contend.
+//
+// Every entry is tagged with the generation of the parser it was computed
+// from. A lookup that started before a parser swap can still put an entry
+// after the cache was cleared, but that entry is never returned for the new
+// generation.
+class ThirdPartyHostsCache {
+ public:
+  explicit ThirdPartyHostsCache(size_t max_entries);
+  ~ThirdPartyHostsCache();
+
+  // Returns nullptr on a miss or if the entry is from another generation.
+  std::shared_ptr<const HostSuffixSet> Get(const std::string& tab_host,
+                                           uint64_t generation);
+  void Put(const std::string& tab_host,
+           uint64_t generation,
+           std::shared_ptr<const HostSuffixSet> hosts);
+  void Clear();
+
+ private:
+  using Entry = std::pair<uint64_t, std::shared_ptr<const HostSuffixSet>>;
+
+  struct Shard {
+    explicit Shard(size_t max_entries);
+    ~Shard();
+
+    base::Lock lock;
+    base::MRUCache<std::string, Entry> entries;
+  };
+
+  Shard* GetShard(const std::string& tab_host);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThirdPartyHostsCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_THIRD_PARTY_HOSTS_CACHE_H_
@@ -0,0 +1,88 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_shields/browser/third_party_hosts_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HostSuffixSet;
+using brave_shields::ThirdPartyHostsCache;
+
+TEST(HostSuffixSetTest, MatchesHostsAndSubdomains) {
+  std::unique_ptr<HostSuffixSet> hosts =
+      HostSuffixSet::FromCommaSeparatedList("fbcdn.net,facebook.com");
+  EXPECT_EQ(2u, hosts->size());
+  EXPECT_TRUE(hosts->Matches("fbcdn.net"));
+  EXPECT_TRUE(hosts->Matches("static.xx.fbcdn.net"));
+  EXPECT_TRUE(hosts->Matches("www.facebook.com"));
+  EXPECT_FALSE(hosts->Matches("notfbcdn.net"));
+  EXPECT_FALSE(hosts->Matches("facebook.com.evil.net"));
+  EXPECT_FALSE(hosts->Matches("net"));
+}
+
+TEST(HostSuffixSetTest, EmptyList) {
+  std::unique_ptr<HostSuffixSet> hosts =
+      HostSuffixSet::FromCommaSeparatedList("");
+  EXPECT_TRUE(hosts->empty());
+  EXPECT_FALSE(hosts->Matches("example.com"));
+}
+
+TEST(ThirdPartyHostsCacheTest, GetAndPut) {
+  ThirdPartyHostsCache cache(16);
+  EXPECT_FALSE(cache.Get("facebook.com", 0));
+  cache.Put("facebook.com", 0,
+            HostSuffixSet::FromCommaSeparatedList("fbcdn.net"));
+  std::shared_ptr<const HostSuffixSet> hosts = cache.Get("facebook.com", 0);
+  ASSERT_TRUE(hosts);
+  EXPECT_TRUE(hosts->Matches("fbcdn.net"));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("facebook.com", 0));
+  // Entries handed out before a clear stay usable.
+  EXPECT_TRUE(hosts->Matches("fbcdn.net"));
+}
+
+TEST(ThirdPartyHostsCacheTest, EvictsLeastRecentlyUsed) {
+  ThirdPartyHostsCache cache(8);
+  for (int i = 0; i < 100; ++i) {
+    cache.Put("site" + base::NumberToString(i) + ".com", 0,
+              HostSuffixSet::FromCommaSeparatedList("cdn.com"));
+  }
+  int cached = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (cache.Get("site" + base::NumberToString(i) + ".com", 0))
+      cached++;
+  }
+  EXPECT_GT(cached, 0);
+  EXPECT_LE(cached, 8);
+  // The most recent insert is always kept.
+  EXPECT_TRUE(cache.Get("site99.com", 0));
+}
+
+TEST(ThirdPartyHostsCacheTest, IgnoresEntriesFromOtherGenerations) {
+  ThirdPartyHostsCache cache(16);
+  cache.Put("facebook.com", 1,
+            HostSuffixSet::FromCommaSeparatedList("fbcdn.net"));
+  EXPECT_TRUE(cache.Get("facebook.com", 1));
+  EXPECT_FALSE(cache.Get("facebook.com", 2));
+
+  // A lookup against the new parser replaces the old entry.
+  cache.Put("facebook.com", 2,
+            HostSuffixSet::FromCommaSeparatedList("fbcdn.com"));
+  std::shared_ptr<const HostSuffixSet> hosts = cache.Get("facebook.com", 2);
+  ASSERT_TRUE(hosts);
+  EXPECT_TRUE(hosts->Matches("fbcdn.com"));
+
+  // A lookup that started before the swap finishes late; it must not
+  // replace the current entry.
+  cache.Put("facebook.com", 1,
+            HostSuffixSet::FromCommaSeparatedList("fbcdn.net"));
+  hosts = cache.Get("facebook.com", 2);
+  ASSERT_TRUE(hosts);
+  EXPECT_TRUE(hosts->Matches("fbcdn.com"));
+}
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
@@ -23,18 +24,23 @@
 
 #define DAT_FILE "TrackingProtection.dat"
 #define DAT_FILE_VERSION "1"
-#define THIRD_PARTY_HOSTS_CACHE_SIZE 20
+#define THIRD_PARTY_HOSTS_CACHE_SIZE 512
 
 namespace brave_shields {
 
 TrackingProtectionService::TrackingProtectionService()
-  : tracking_protection_client_(new CTPParser()),
-    weak_factory_(this) {
+  : tracking_protection_clients_generation_(0),
+    third_party_hosts_cache_(THIRD_PARTY_HOSTS_CACHE_SIZE) {
+  std::vector<std::unique_ptr<CTPParser>> parsers;
+  parsers.push_back(std::make_unique<CTPParser>());
+  tracking_protection_clients_ =
+      std::make_shared<MatcherPool<CTPParser>>(std::move(parsers));
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 TrackingProtectionService::~TrackingProtectionService() {
-  tracking_protection_client_.reset();
+  base::AutoLock lock(tracking_protection_clients_lock_);
+  tracking_protection_clients_.reset();
 }
 
 bool TrackingProtectionService::ShouldStartRequest(const GURL& url,
@@ -42,49 +48,83 @@ bool TrackingProtectionService::ShouldStartRequest(const GURL& url,
     const std::string &tab_host,
     bool* matching_exception_filter,
     bool* cancel_request_explicitly) {
+  ShieldsRequest request(url, resource_type, tab_host);
+  return ShouldStartRequest(request, matching_exception_filter,
+                            cancel_request_explicitly);
+}
+
+bool TrackingProtectionService::ShouldStartRequest(
+    const ShieldsRequest& request,
+    bool* matching_exception_filter,
+    bool* cancel_request_explicitly) {
   // There are no exceptions in the TP service, but exceptions are
   // combined with brave/ad-block.
   if (matching_exception_filter) {
     *matching_exception_filter = false;
   }
   // Intentionally don't set cancel_request_explicitly
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  std::string host = url.host();
-  if (!tracking_protection_client_->matchesTracker(
-        tab_host.c_str(), host.c_str())) {
+  uint64_t generation = 0;
+  std::shared_ptr<MatcherPool<CTPParser>> clients =
+      GetTrackingProtectionClients(&generation);
+  if (!clients) {
     return true;
   }
-
-  std::vector<std::string> hosts(GetThirdPartyHosts(tab_host));
-  for (size_t i = 0; i < hosts.size(); i++) {
-    if (host == hosts[i] ||
-        host.find((std::string)"." + hosts[i]) != std::string::npos) {
-      return true;
-    }
-    size_t iPos = host.find((std::string)"." + hosts[i]);
-    if (iPos == std::string::npos) {
-      continue;
-    }
-    if (hosts[i].length() + ((std::string)".").length() + iPos ==
-        host.length()) {
+  {
+    // CTPParser lookups are not known to be reentrant, so the lookup runs on
+    // a parser that no other lookup is using.
+    MatcherPool<CTPParser>::ScopedMatcher client = clients->Acquire();
+    if (!client->matchesTracker(request.tab_host.c_str(),
+                                request.host.c_str())) {
       return true;
     }
   }
-  return false;
+
+  std::shared_ptr<const HostSuffixSet> hosts =
+      GetThirdPartyHosts(clients.get(), generation, request.tab_host);
+  return hosts->Matches(request.host);
 }
 
-void TrackingProtectionService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
+void TrackingProtectionService::GetDATFileDataOnTaskRunner(
+    const base::FilePath& dat_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::shared_ptr<DATFileData> buffer = LoadDATFileData(dat_file_path);
+  if (!buffer) {
     LOG(ERROR) << "Could not obtain tracking protection data";
     return;
   }
-  tracking_protection_client_.reset(new CTPParser());
-  if (!tracking_protection_client_->deserialize(
-        reinterpret_cast<char*>(&buffer_.front()))) {
-    tracking_protection_client_.reset();
-    LOG(ERROR) << "Failed to deserialize tracking protection data";
-    return;
+  std::vector<std::unique_ptr<CTPParser>> parsers;
+  const size_t pool_size = GetMatcherPoolSize();
+  while (parsers.size() < pool_size) {
+    std::unique_ptr<CTPParser> parser(new CTPParser());
+    if (!parser->deserialize(buffer->data())) {
+      parsers.clear();
+      LOG(ERROR) << "Failed to deserialize tracking protection data";
+      break;
+    }
+    parsers.push_back(std::move(parser));
+  }
+
+  // The parsers point into |buffer|, so the pool keeps the buffer alive.
+  std::shared_ptr<MatcherPool<CTPParser>> new_clients;
+  if (!parsers.empty()) {
+    new_clients.reset(new MatcherPool<CTPParser>(std::move(parsers)),
+        [buffer](MatcherPool<CTPParser>* parsers) { delete parsers; });
+  }
+  {
+    base::AutoLock lock(tracking_protection_clients_lock_);
+    tracking_protection_clients_.swap(new_clients);
+    tracking_protection_clients_generation_++;
   }
+  // Cleared after the swap only to free memory: entries computed from the old
+  // parser are tagged with its generation and never returned again.
+  third_party_hosts_cache_.Clear();
+}
+
+std::shared_ptr<MatcherPool<CTPParser>>
+TrackingProtectionService::GetTrackingProtectionClients(uint64_t* generation) {
+  base::AutoLock lock(tracking_protection_clients_lock_);
+  *generation = tracking_protection_clients_generation_;
+  return tracking_protection_clients_;
 }
 
 void TrackingProtectionService::OnComponentReady(
@@ -94,65 +134,36 @@ void TrackingProtectionService::OnComponentReady(
   base::FilePath dat_file_path =
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
 
-  GetTaskRunner()->PostTaskAndReply(
+  GetTaskRunner()->PostTask(
       FROM_HERE,
-      base::Bind(&GetDATFileData, dat_file_path, &buffer_),
-      base::Bind(&TrackingProtectionService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
+      base::BindOnce(&TrackingProtectionService::GetDATFileDataOnTaskRunner,
+                     base::Unretained(this), dat_file_path));
 }
 
 // Ported from Android: net/blockers/blockers_worker.cc
-std::vector<std::string>
-TrackingProtectionService::GetThirdPartyHosts(const std::string& base_host) {
-  {
-    std::lock_guard<std::mutex> guard(third_party_hosts_mutex_);
-    std::map<std::string, std::vector<std::string>>::const_iterator iter =
-      third_party_hosts_cache_.find(base_host);
-    if (third_party_hosts_cache_.end() != iter) {
-      if (third_party_base_hosts_.size() != 0
-          && third_party_base_hosts_[third_party_hosts_cache_.size() - 1] !=
-          base_host) {
-        for (size_t i = 0; i < third_party_base_hosts_.size(); i++) {
-          if (third_party_base_hosts_[i] == base_host) {
-            third_party_base_hosts_.erase(third_party_base_hosts_.begin() + i);
-            third_party_base_hosts_.push_back(base_host);
-            break;
-          }
-        }
-      }
-      return iter->second;
-    }
+std::shared_ptr<const HostSuffixSet>
+TrackingProtectionService::GetThirdPartyHosts(
+    MatcherPool<CTPParser>* clients,
+    uint64_t generation,
+    const std::string& base_host) {
+  std::shared_ptr<const HostSuffixSet> hosts =
+      third_party_hosts_cache_.Get(base_host, generation);
+  if (hosts) {
+    return hosts;
   }
 
-  char* thirdPartyHosts =
-    tracking_protection_client_->findFirstPartyHosts(base_host.c_str());
-  std::vector<std::string> hosts;
+  char* thirdPartyHosts = nullptr;
+  {
+    MatcherPool<CTPParser>::ScopedMatcher client = clients->Acquire();
+    thirdPartyHosts = client->findFirstPartyHosts(base_host.c_str());
+  }
   if (nullptr != thirdPartyHosts) {
-    std::string strThirdPartyHosts = thirdPartyHosts;
-    size_t iPos = strThirdPartyHosts.find(",");
-    while (iPos != std::string::npos) {
-      std::string thirdParty = strThirdPartyHosts.substr(0, iPos);
-      strThirdPartyHosts = strThirdPartyHosts.substr(iPos + 1);
-      iPos = strThirdPartyHosts.find(",");
-      hosts.push_back(thirdParty);
-    }
-    if (0 != strThirdPartyHosts.length()) {
-      hosts.push_back(strThirdPartyHosts);
-    }
+    hosts = HostSuffixSet::FromCommaSeparatedList(thirdPartyHosts);
     delete []thirdPartyHosts;
+  } else {
+    hosts = std::make_shared<HostSuffixSet>(std::vector<std::string>());
   }
-
-  {
-    std::lock_guard<std::mutex> guard(third_party_hosts_mutex_);
-    if (third_party_hosts_cache_.size() == THIRD_PARTY_HOSTS_CACHE_SIZE &&
-        third_party_base_hosts_.size() == THIRD_PARTY_HOSTS_CACHE_SIZE) {
-      third_party_hosts_cache_.erase(third_party_base_hosts_[0]);
-      third_party_base_hosts_.erase(third_party_base_hosts_.begin());
-    }
-    third_party_base_hosts_.push_back(base_host);
-    third_party_hosts_cache_.insert(
-        std::pair<std::string, std::vector<std::string>>(base_host, hosts));
-  }
+  third_party_hosts_cache_.Put(base_host, generation, hosts);
 
   return hosts;
 }
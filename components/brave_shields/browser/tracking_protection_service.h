@@ -8,19 +8,18 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
-// TODO(brave): <mutex> is an unapproved C++11 header
-#include <mutex>  // NOLINT
 #include <string>
-#include <vector>
 
 #include "base/files/file_path.h"
-#include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_local_data_files_observer.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/matcher_pool.h"
+#include "brave/components/brave_shields/browser/shields_request.h"
+#include "brave/components/brave_shields/browser/third_party_hosts_cache.h"
 #include "content/public/common/resource_type.h"
 #include "url/gurl.h"
 
@@ -35,11 +34,15 @@ class TrackingProtectionService : public BaseLocalDataFilesObserver {
   TrackingProtectionService();
   ~TrackingProtectionService() override;
 
+  // Can be called from any thread.
   bool ShouldStartRequest(const GURL& spec,
                           content::ResourceType resource_type,
                           const std::string& tab_host,
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly);
+  bool ShouldStartRequest(const ShieldsRequest& request,
+                          bool* matching_exception_filter,
+                          bool* cancel_request_explicitly);
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of BaseLocalDataFilesObserver
@@ -48,18 +51,26 @@ class TrackingProtectionService : public BaseLocalDataFilesObserver {
                         const std::string& manifest) override;
 
  private:
-  void OnDATFileDataReady();
-  std::vector<std::string> GetThirdPartyHosts(const std::string& base_host);
-
-  brave_shields::DATFileDataBuffer buffer_;
-
-  std::unique_ptr<CTPParser> tracking_protection_client_;
-  std::vector<std::string> third_party_base_hosts_;
-  std::map<std::string, std::vector<std::string>> third_party_hosts_cache_;
-  std::mutex third_party_hosts_mutex_;
+  void GetDATFileDataOnTaskRunner(const base::FilePath& dat_file_path);
+  // Returns the current parser and sets |generation| to the generation it
+  // was published with.
+  std::shared_ptr<MatcherPool<CTPParser>> GetTrackingProtectionClients(
+      uint64_t* generation);
+  std::shared_ptr<const HostSuffixSet> GetThirdPartyHosts(
+      MatcherPool<CTPParser>* clients,
+      uint64_t generation,
+      const std::string& base_host);
+
+  // The parsers are swapped as a whole when new data arrives. Their lookups
+  // are not known to be thread-safe, so each lookup takes a parser from the
+  // pool that no other lookup is using.
+  base::Lock tracking_protection_clients_lock_;
+  std::shared_ptr<MatcherPool<CTPParser>> tracking_protection_clients_;
+  // Bumped under |tracking_protection_clients_lock_| on every swap.
+  uint64_t tracking_protection_clients_generation_;
+  ThirdPartyHostsCache third_party_hosts_cache_;
 
   SEQUENCE_CHECKER(sequence_checker_);
-  base::WeakPtrFactory<TrackingProtectionService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(TrackingProtectionService);
 };
 
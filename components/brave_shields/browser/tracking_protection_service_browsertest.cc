@@ -3,12 +3,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/local_data_files_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "chrome/browser/ui/browser.h"
@@ -102,6 +104,12 @@ public:
     return true;
   }
 
+  void WaitForBlockedEvents() {
+    base::RunLoop run_loop;
+    brave_shields::FlushBlockedEventsFromIOForTesting(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
   void WaitForTrackingProtectionServiceThread() {
     scoped_refptr<base::ThreadTestHelper> io_helper(
         new base::ThreadTestHelper(
@@ -132,6 +140,7 @@ IN_PROC_BROWSER_TEST_F(TrackingProtectionServiceTest, TrackerReferencedFromTrust
       &img_loaded));
   EXPECT_TRUE(img_loaded);
 
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kTrackersBlocked), 0ULL);
 }
 
@@ -156,5 +165,6 @@ IN_PROC_BROWSER_TEST_F(TrackingProtectionServiceTest, TrackerReferencedFromUntru
       &img_loaded));
   EXPECT_FALSE(img_loaded);
 
+  WaitForBlockedEvents();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kTrackersBlocked), 1ULL);
 }
@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/optional.h"
+#include "brave/components/services/bat_ledger/public/cpp/bat_ledger_struct_traits.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 namespace bat_ledger {
@@ -323,13 +325,9 @@ void BatLedgerClientMojoProxy::SavePublishersList(
 }
 
 void OnSavePublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::SavePublisherInfo(
@@ -341,19 +339,15 @@ void BatLedgerClientMojoProxy::SavePublisherInfo(
     return;
   }
 
-  std::string json_info = publisher_info ? publisher_info->ToJson() : "";
-  bat_ledger_client_->SavePublisherInfo(json_info,
+  bat_ledger_client_->SavePublisherInfo(
+      ToMojomPublisherInfo(std::move(publisher_info)),
       base::BindOnce(&OnSavePublisherInfo, std::move(callback)));
 }
 
 void OnLoadPublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadPublisherInfo(
@@ -370,15 +364,9 @@ void BatLedgerClientMojoProxy::LoadPublisherInfo(
 }
 
 void OnLoadPanelPublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadPanelPublisherInfo(
@@ -395,13 +383,9 @@ void BatLedgerClientMojoProxy::LoadPanelPublisherInfo(
 }
 
 void OnLoadMediaPublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadMediaPublisherInfo(
@@ -451,9 +435,8 @@ void BatLedgerClientMojoProxy::OnPanelPublisherInfo(ledger::Result result,
     return;
   }
 
-  std::string json_info = info ? info->ToJson() : "";
   bat_ledger_client_->OnPanelPublisherInfo(ToMojomResult(result),
-      json_info, windowId);
+      ToMojomPublisherInfo(std::move(info)), windowId);
 }
 
 void OnFetchFavIcon(const ledger::FetchIconCallback& callback,
@@ -474,17 +457,9 @@ void BatLedgerClientMojoProxy::FetchFavIcon(const std::string& url,
 }
 
 void OnGetRecurringDonations(const ledger::PublisherInfoListCallback& callback,
-    const std::vector<std::string>& publisher_info_list,
+    const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  ledger::PublisherInfoList list;
-
-  for (const auto& publisher_info : publisher_info_list) {
-    ledger::PublisherInfo info;
-    info.loadFromJson(publisher_info);
-    list.push_back(info);
-  }
-
-  callback(list, next_record);
+  callback(publisher_info_list, next_record);
 }
 
 void BatLedgerClientMojoProxy::GetRecurringDonations(
@@ -594,13 +569,9 @@ void BatLedgerClientMojoProxy::SavePendingContribution(
 }
 
 void OnLoadActivityInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadActivityInfo(
@@ -617,13 +588,9 @@ void BatLedgerClientMojoProxy::LoadActivityInfo(
 }
 
 void OnSaveActivityInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::SaveActivityInfo(
@@ -635,8 +602,8 @@ void BatLedgerClientMojoProxy::SaveActivityInfo(
     return;
   }
 
-  std::string json_info = publisher_info ? publisher_info->ToJson() : "";
-  bat_ledger_client_->SaveActivityInfo(json_info,
+  bat_ledger_client_->SaveActivityInfo(
+      ToMojomPublisherInfo(std::move(publisher_info)),
       base::BindOnce(&OnSaveActivityInfo, std::move(callback)));
 }
 
@@ -657,17 +624,9 @@ void BatLedgerClientMojoProxy::OnRestorePublishers(
 }
 
 void OnGetActivityInfoList(const ledger::PublisherInfoListCallback& callback,
-    const std::vector<std::string>& publisher_info_list,
+    const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  ledger::PublisherInfoList list;
-
-  for (const auto& publisher_info : publisher_info_list) {
-    ledger::PublisherInfo info;
-    info.loadFromJson(publisher_info);
-    list.push_back(info);
-  }
-
-  callback(list, next_record);
+  callback(publisher_info_list, next_record);
 }
 
 void BatLedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
@@ -692,7 +651,7 @@ void BatLedgerClientMojoProxy::SaveNormalizedPublisherList(
     return;
   }
 
-  bat_ledger_client_->SaveNormalizedPublisherList(normalized_list.ToJson());
+  bat_ledger_client_->SaveNormalizedPublisherList(normalized_list.list);
 }
 
 void BatLedgerClientMojoProxy::SaveState(
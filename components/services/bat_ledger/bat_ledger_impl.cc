@@ -96,11 +96,9 @@ void BatLedgerImpl::GetReconcileStamp(GetReconcileStampCallback callback) {
   std::move(callback).Run(ledger_->GetReconcileStamp());
 }
 
-void BatLedgerImpl::OnLoad(const std::string& visit_data,
+void BatLedgerImpl::OnLoad(const ledger::VisitData& visit_data,
     uint64_t current_time) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnLoad(visitData, current_time);
+  ledger_->OnLoad(visit_data, current_time);
 }
 
 void BatLedgerImpl::OnUnload(uint32_t tab_id, uint64_t current_time) {
@@ -133,20 +131,16 @@ void BatLedgerImpl::OnMediaStop(uint32_t tab_id, uint64_t current_time) {
 
 void BatLedgerImpl::OnPostData(const std::string& url,
     const std::string& first_party_url, const std::string& referrer,
-    const std::string& post_data, const std::string& visit_data) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnPostData(url, first_party_url, referrer, post_data, visitData);
+    const std::string& post_data, const ledger::VisitData& visit_data) {
+  ledger_->OnPostData(url, first_party_url, referrer, post_data, visit_data);
 }
 
 void BatLedgerImpl::OnXHRLoad(uint32_t tab_id, const std::string& url,
     const base::flat_map<std::string, std::string>& parts,
     const std::string& first_party_url, const std::string& referrer,
-    const std::string& visit_data) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnXHRLoad(tab_id, url, mojo::FlatMapToMap(parts),
-        first_party_url, referrer, visitData);
+    const ledger::VisitData& visit_data) {
+  ledger_->OnXHRLoad(tab_id, url, mojo::FlatMapToMap(parts),
+      first_party_url, referrer, visit_data);
 }
 
 void BatLedgerImpl::SetPublisherExclude(const std::string& publisher_key,
@@ -272,12 +266,8 @@ void BatLedgerImpl::OnTimer(uint32_t timer_id) {
 
 void BatLedgerImpl::GetAllBalanceReports(
     GetAllBalanceReportsCallback callback) {
-  auto reports = ledger_->GetAllBalanceReports();
-  base::flat_map<std::string, std::string> out_reports;
-  for (auto const& report : reports) {
-    out_reports[report.first] = report.second.ToJson();
-  }
-  std::move(callback).Run(out_reports);
+  std::move(callback).Run(
+      mojo::MapToFlatMap(ledger_->GetAllBalanceReports()));
 }
 
 void BatLedgerImpl::GetBalanceReport(int32_t month, int32_t year,
@@ -285,7 +275,7 @@ void BatLedgerImpl::GetBalanceReport(int32_t month, int32_t year,
   ledger::BalanceReportInfo info;
   bool result =
     ledger_->GetBalanceReport(ToLedgerPublisherMonth(month), year, &info);
-  std::move(callback).Run(result, info.ToJson());
+  std::move(callback).Run(result, info);
 }
 
 void BatLedgerImpl::IsWalletCreated(IsWalletCreatedCallback callback) {
@@ -294,11 +284,9 @@ void BatLedgerImpl::IsWalletCreated(IsWalletCreatedCallback callback) {
 
 void BatLedgerImpl::GetPublisherActivityFromUrl(
     uint64_t window_id,
-    const std::string& visit_data,
+    const ledger::VisitData& visit_data,
     const std::string& publisher_blob) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->GetPublisherActivityFromUrl(window_id, visitData, publisher_blob);
+  ledger_->GetPublisherActivityFromUrl(window_id, visit_data, publisher_blob);
 }
 
 // static
@@ -325,12 +313,11 @@ void BatLedgerImpl::GetContributionAmount(
   std::move(callback).Run(ledger_->GetContributionAmount());
 }
 
-void BatLedgerImpl::DoDirectDonation(const std::string& publisher_info,
-                                     int32_t amount,
-                                     const std::string& currency) {
-  ledger::PublisherInfo info;
-  if (info.loadFromJson(publisher_info))
-    ledger_->DoDirectDonation(info, amount, currency);
+void BatLedgerImpl::DoDirectDonation(
+    const ledger::PublisherInfo& publisher_info,
+    int32_t amount,
+    const std::string& currency) {
+  ledger_->DoDirectDonation(publisher_info, amount, currency);
 }
 
 void BatLedgerImpl::RemoveRecurring(const std::string& publisher_key) {
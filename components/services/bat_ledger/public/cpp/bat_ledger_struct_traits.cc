@@ -0,0 +1,82 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/bat_ledger_struct_traits.h"
+
+namespace mojo {
+
+// static
+bool StructTraits<bat_ledger::mojom::VisitDataDataView,
+                  ledger::VisitData>::
+    Read(bat_ledger::mojom::VisitDataDataView in,
+         ledger::VisitData* out) {
+  if (!in.ReadTld(&out->tld) ||
+      !in.ReadDomain(&out->domain) ||
+      !in.ReadPath(&out->path) ||
+      !in.ReadName(&out->name) ||
+      !in.ReadUrl(&out->url) ||
+      !in.ReadProvider(&out->provider) ||
+      !in.ReadFaviconUrl(&out->favicon_url))
+    return false;
+
+  out->tab_id = in.tab_id();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ledger::mojom::ContributionInfoDataView,
+                  ledger::ContributionInfo>::
+    Read(bat_ledger::mojom::ContributionInfoDataView in,
+         ledger::ContributionInfo* out) {
+  if (!in.ReadPublisher(&out->publisher))
+    return false;
+
+  out->value = in.value();
+  out->date = in.date();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ledger::mojom::PublisherInfoDataView,
+                  ledger::PublisherInfo>::
+    Read(bat_ledger::mojom::PublisherInfoDataView in,
+         ledger::PublisherInfo* out) {
+  if (!in.ReadId(&out->id) ||
+      !in.ReadName(&out->name) ||
+      !in.ReadUrl(&out->url) ||
+      !in.ReadProvider(&out->provider) ||
+      !in.ReadFaviconUrl(&out->favicon_url) ||
+      !in.ReadContributions(&out->contributions))
+    return false;
+
+  out->duration = in.duration();
+  out->score = in.score();
+  out->visits = in.visits();
+  out->percent = in.percent();
+  out->weight = in.weight();
+  out->excluded = static_cast<ledger::PUBLISHER_EXCLUDE>(in.excluded());
+  out->category = static_cast<ledger::REWARDS_CATEGORY>(in.category());
+  out->reconcile_stamp = in.reconcile_stamp();
+  out->verified = in.verified();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ledger::mojom::BalanceReportInfoDataView,
+                  ledger::BalanceReportInfo>::
+    Read(bat_ledger::mojom::BalanceReportInfoDataView in,
+         ledger::BalanceReportInfo* out) {
+  return in.ReadOpeningBalance(&out->opening_balance_) &&
+      in.ReadClosingBalance(&out->closing_balance_) &&
+      in.ReadDeposits(&out->deposits_) &&
+      in.ReadGrants(&out->grants_) &&
+      in.ReadEarningFromAds(&out->earning_from_ads_) &&
+      in.ReadAutoContribute(&out->auto_contribute_) &&
+      in.ReadRecurringDonation(&out->recurring_donation_) &&
+      in.ReadOneTimeDonation(&out->one_time_donation_) &&
+      in.ReadTotal(&out->total_);
+}
+
+}  // namespace mojo
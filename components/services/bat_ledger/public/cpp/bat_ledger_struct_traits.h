@@ -0,0 +1,219 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_BAT_LEDGER_STRUCT_TRAITS_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_BAT_LEDGER_STRUCT_TRAITS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/optional.h"
+#include "bat/ledger/balance_report_info.h"
+#include "bat/ledger/ledger.h"
+#include "bat/ledger/publisher_info.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom-shared.h"
+#include "mojo/public/cpp/bindings/struct_traits.h"
+
+namespace mojo {
+
+template <>
+struct StructTraits<bat_ledger::mojom::VisitDataDataView,
+                    ledger::VisitData> {
+  static const std::string& tld(const ledger::VisitData& data) {
+    return data.tld;
+  }
+
+  static const std::string& domain(const ledger::VisitData& data) {
+    return data.domain;
+  }
+
+  static const std::string& path(const ledger::VisitData& data) {
+    return data.path;
+  }
+
+  static uint32_t tab_id(const ledger::VisitData& data) {
+    return data.tab_id;
+  }
+
+  static const std::string& name(const ledger::VisitData& data) {
+    return data.name;
+  }
+
+  static const std::string& url(const ledger::VisitData& data) {
+    return data.url;
+  }
+
+  static const std::string& provider(const ledger::VisitData& data) {
+    return data.provider;
+  }
+
+  static const std::string& favicon_url(const ledger::VisitData& data) {
+    return data.favicon_url;
+  }
+
+  static bool Read(bat_ledger::mojom::VisitDataDataView in,
+                   ledger::VisitData* out);
+};
+
+template <>
+struct StructTraits<bat_ledger::mojom::ContributionInfoDataView,
+                    ledger::ContributionInfo> {
+  static const std::string& publisher(const ledger::ContributionInfo& info) {
+    return info.publisher;
+  }
+
+  static double value(const ledger::ContributionInfo& info) {
+    return info.value;
+  }
+
+  static uint64_t date(const ledger::ContributionInfo& info) {
+    return info.date;
+  }
+
+  static bool Read(bat_ledger::mojom::ContributionInfoDataView in,
+                   ledger::ContributionInfo* out);
+};
+
+template <>
+struct StructTraits<bat_ledger::mojom::PublisherInfoDataView,
+                    ledger::PublisherInfo> {
+  static const std::string& id(const ledger::PublisherInfo& info) {
+    return info.id;
+  }
+
+  static uint64_t duration(const ledger::PublisherInfo& info) {
+    return info.duration;
+  }
+
+  static double score(const ledger::PublisherInfo& info) {
+    return info.score;
+  }
+
+  static uint32_t visits(const ledger::PublisherInfo& info) {
+    return info.visits;
+  }
+
+  static uint32_t percent(const ledger::PublisherInfo& info) {
+    return info.percent;
+  }
+
+  static double weight(const ledger::PublisherInfo& info) {
+    return info.weight;
+  }
+
+  static int32_t excluded(const ledger::PublisherInfo& info) {
+    return info.excluded;
+  }
+
+  static int32_t category(const ledger::PublisherInfo& info) {
+    return info.category;
+  }
+
+  static uint64_t reconcile_stamp(const ledger::PublisherInfo& info) {
+    return info.reconcile_stamp;
+  }
+
+  static bool verified(const ledger::PublisherInfo& info) {
+    return info.verified;
+  }
+
+  static const std::string& name(const ledger::PublisherInfo& info) {
+    return info.name;
+  }
+
+  static const std::string& url(const ledger::PublisherInfo& info) {
+    return info.url;
+  }
+
+  static const std::string& provider(const ledger::PublisherInfo& info) {
+    return info.provider;
+  }
+
+  static const std::string& favicon_url(const ledger::PublisherInfo& info) {
+    return info.favicon_url;
+  }
+
+  static const std::vector<ledger::ContributionInfo>& contributions(
+      const ledger::PublisherInfo& info) {
+    return info.contributions;
+  }
+
+  static bool Read(bat_ledger::mojom::PublisherInfoDataView in,
+                   ledger::PublisherInfo* out);
+};
+
+template <>
+struct StructTraits<bat_ledger::mojom::BalanceReportInfoDataView,
+                    ledger::BalanceReportInfo> {
+  static const std::string& opening_balance(
+      const ledger::BalanceReportInfo& report) {
+    return report.opening_balance_;
+  }
+
+  static const std::string& closing_balance(
+      const ledger::BalanceReportInfo& report) {
+    return report.closing_balance_;
+  }
+
+  static const std::string& deposits(const ledger::BalanceReportInfo& report) {
+    return report.deposits_;
+  }
+
+  static const std::string& grants(const ledger::BalanceReportInfo& report) {
+    return report.grants_;
+  }
+
+  static const std::string& earning_from_ads(
+      const ledger::BalanceReportInfo& report) {
+    return report.earning_from_ads_;
+  }
+
+  static const std::string& auto_contribute(
+      const ledger::BalanceReportInfo& report) {
+    return report.auto_contribute_;
+  }
+
+  static const std::string& recurring_donation(
+      const ledger::BalanceReportInfo& report) {
+    return report.recurring_donation_;
+  }
+
+  static const std::string& one_time_donation(
+      const ledger::BalanceReportInfo& report) {
+    return report.one_time_donation_;
+  }
+
+  static const std::string& total(const ledger::BalanceReportInfo& report) {
+    return report.total_;
+  }
+
+  static bool Read(bat_ledger::mojom::BalanceReportInfoDataView in,
+                   ledger::BalanceReportInfo* out);
+};
+
+}  // namespace mojo
+
+namespace bat_ledger {
+
+// Nullable PublisherInfo parameters are optional in mojom and owned pointers
+// in the ledger API. Both ledger client proxies convert between them.
+inline std::unique_ptr<ledger::PublisherInfo> ToLedgerPublisherInfo(
+    const base::Optional<ledger::PublisherInfo>& info) {
+  if (!info)
+    return nullptr;
+  return std::make_unique<ledger::PublisherInfo>(info.value());
+}
+
+inline base::Optional<ledger::PublisherInfo> ToMojomPublisherInfo(
+    std::unique_ptr<ledger::PublisherInfo> info) {
+  if (!info)
+    return base::nullopt;
+  return *info;
+}
+
+}  // namespace bat_ledger
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_BAT_LEDGER_STRUCT_TRAITS_H_
@@ -0,0 +1,103 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/bat_ledger_struct_traits.h"
+
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
+#include "mojo/public/cpp/test_support/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerStructTraitsTest.*
+
+namespace bat_ledger {
+
+TEST(BatLedgerStructTraitsTest, VisitData) {
+  ledger::VisitData input("brave.com", "www.brave.com", "/about", 7,
+      "brave.com", "https://www.brave.com/about", "youtube",
+      "https://www.brave.com/favicon.ico");
+  ledger::VisitData output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::VisitData>(
+      &input, &output));
+
+  EXPECT_EQ(input.tld, output.tld);
+  EXPECT_EQ(input.domain, output.domain);
+  EXPECT_EQ(input.path, output.path);
+  EXPECT_EQ(input.tab_id, output.tab_id);
+  EXPECT_EQ(input.name, output.name);
+  EXPECT_EQ(input.url, output.url);
+  EXPECT_EQ(input.provider, output.provider);
+  EXPECT_EQ(input.favicon_url, output.favicon_url);
+}
+
+TEST(BatLedgerStructTraitsTest, PublisherInfo) {
+  ledger::PublisherInfo input("brave.com");
+  input.duration = 120;
+  input.score = 1.5;
+  input.visits = 3;
+  input.percent = 40;
+  input.weight = 38.2;
+  input.excluded = ledger::PUBLISHER_EXCLUDE::INCLUDED;
+  input.category = ledger::REWARDS_CATEGORY::RECURRING_DONATION;
+  input.reconcile_stamp = 1553423066;
+  input.verified = true;
+  input.name = "Brave";
+  input.url = "https://brave.com";
+  input.favicon_url = "https://brave.com/favicon.ico";
+  ledger::ContributionInfo contribution(5.0, 1553423067);
+  contribution.publisher = "brave.com";
+  input.contributions.push_back(contribution);
+
+  ledger::PublisherInfo output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::PublisherInfo>(
+      &input, &output));
+
+  EXPECT_EQ(input.id, output.id);
+  EXPECT_EQ(input.duration, output.duration);
+  EXPECT_EQ(input.score, output.score);
+  EXPECT_EQ(input.visits, output.visits);
+  EXPECT_EQ(input.percent, output.percent);
+  EXPECT_EQ(input.weight, output.weight);
+  EXPECT_EQ(input.excluded, output.excluded);
+  EXPECT_EQ(input.category, output.category);
+  EXPECT_EQ(input.reconcile_stamp, output.reconcile_stamp);
+  EXPECT_EQ(input.verified, output.verified);
+  EXPECT_EQ(input.name, output.name);
+  EXPECT_EQ(input.url, output.url);
+  EXPECT_EQ(input.provider, output.provider);
+  EXPECT_EQ(input.favicon_url, output.favicon_url);
+  ASSERT_EQ(1u, output.contributions.size());
+  EXPECT_EQ("brave.com", output.contributions[0].publisher);
+  EXPECT_EQ(5.0, output.contributions[0].value);
+  EXPECT_EQ(1553423067u, output.contributions[0].date);
+}
+
+TEST(BatLedgerStructTraitsTest, BalanceReportInfo) {
+  ledger::BalanceReportInfo input;
+  input.opening_balance_ = "1";
+  input.closing_balance_ = "2";
+  input.deposits_ = "3";
+  input.grants_ = "4";
+  input.earning_from_ads_ = "5";
+  input.auto_contribute_ = "6";
+  input.recurring_donation_ = "7";
+  input.one_time_donation_ = "8";
+  input.total_ = "9";
+
+  ledger::BalanceReportInfo output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::BalanceReportInfo>(
+      &input, &output));
+
+  EXPECT_EQ(input.opening_balance_, output.opening_balance_);
+  EXPECT_EQ(input.closing_balance_, output.closing_balance_);
+  EXPECT_EQ(input.deposits_, output.deposits_);
+  EXPECT_EQ(input.grants_, output.grants_);
+  EXPECT_EQ(input.earning_from_ads_, output.earning_from_ads_);
+  EXPECT_EQ(input.auto_contribute_, output.auto_contribute_);
+  EXPECT_EQ(input.recurring_donation_, output.recurring_donation_);
+  EXPECT_EQ(input.one_time_donation_, output.one_time_donation_);
+  EXPECT_EQ(input.total_, output.total_);
+}
+
+}  // namespace bat_ledger
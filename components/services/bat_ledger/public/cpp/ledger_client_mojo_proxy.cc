@@ -6,6 +6,8 @@
 #include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
 
 #include "base/logging.h"
+#include "base/optional.h"
+#include "brave/components/services/bat_ledger/public/cpp/bat_ledger_struct_traits.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 using std::placeholders::_1;
@@ -236,25 +238,19 @@ void LedgerClientMojoProxy::OnSavePublisherInfo(
     CallbackHolder<SavePublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+        ToMojomPublisherInfo(std::move(info)));
   delete holder;
 }
 
 void LedgerClientMojoProxy::SavePublisherInfo(
-    const std::string& publisher_info,
+    const base::Optional<ledger::PublisherInfo>& publisher_info,
     SavePublisherInfoCallback callback) {
   // deleted in OnSavePublisherInfo
   auto* holder = new CallbackHolder<SavePublisherInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-
-  ledger_client_->SavePublisherInfo(std::move(info),
+  ledger_client_->SavePublisherInfo(ToLedgerPublisherInfo(publisher_info),
       std::bind(LedgerClientMojoProxy::OnSavePublisherInfo, holder, _1, _2));
 }
 
@@ -263,9 +259,9 @@ void LedgerClientMojoProxy::OnLoadPublisherInfo(
     CallbackHolder<LoadPublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+        ToMojomPublisherInfo(std::move(info)));
   delete holder;
 }
 
@@ -283,9 +279,9 @@ void LedgerClientMojoProxy::LoadPublisherInfo(
 void LedgerClientMojoProxy::OnLoadPanelPublisherInfo(
     CallbackHolder<LoadPanelPublisherInfoCallback>* holder,
     ledger::Result result, std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+        ToMojomPublisherInfo(std::move(info)));
   delete holder;
 }
 
@@ -306,9 +302,9 @@ void LedgerClientMojoProxy::OnLoadMediaPublisherInfo(
     CallbackHolder<LoadMediaPublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+        ToMojomPublisherInfo(std::move(info)));
   delete holder;
 }
 
@@ -343,14 +339,9 @@ void LedgerClientMojoProxy::OnExcludedSitesChanged(
 }
 
 void LedgerClientMojoProxy::OnPanelPublisherInfo(int32_t result,
-    const std::string& info, uint64_t window_id) {
-  std::unique_ptr<ledger::PublisherInfo> publisher_info;
-  if (!info.empty()) {
-    publisher_info.reset(new ledger::PublisherInfo());
-    publisher_info->loadFromJson(info);
-  }
+    const base::Optional<ledger::PublisherInfo>& info, uint64_t window_id) {
   ledger_client_->OnPanelPublisherInfo(ToLedgerResult(result),
-      std::move(publisher_info), window_id);
+      ToLedgerPublisherInfo(info), window_id);
 }
 
 // static
@@ -376,13 +367,8 @@ void LedgerClientMojoProxy::OnGetRecurringDonations(
     CallbackHolder<GetRecurringDonationsCallback>* holder,
     const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  std::vector<std::string> list;
-  for (const auto& publisher_info : publisher_info_list) {
-    list.push_back(publisher_info.ToJson());
-  }
-
   if (holder->is_valid())
-    std::move(holder->get()).Run(list, next_record);
+    std::move(holder->get()).Run(publisher_info_list, next_record);
   delete holder;
 }
 
@@ -501,9 +487,9 @@ void LedgerClientMojoProxy::OnLoadActivityInfo(
     CallbackHolder<LoadActivityInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+        ToMojomPublisherInfo(std::move(info)));
   delete holder;
 }
 
@@ -524,25 +510,19 @@ void LedgerClientMojoProxy::OnSaveActivityInfo(
     CallbackHolder<SaveActivityInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+        ToMojomPublisherInfo(std::move(info)));
   delete holder;
 }
 
 void LedgerClientMojoProxy::SaveActivityInfo(
-    const std::string& publisher_info,
+    const base::Optional<ledger::PublisherInfo>& publisher_info,
     SaveActivityInfoCallback callback) {
   // deleted in OnSaveActivityInfo
   auto* holder = new CallbackHolder<SaveActivityInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-
-  ledger_client_->SaveActivityInfo(std::move(info),
+  ledger_client_->SaveActivityInfo(ToLedgerPublisherInfo(publisher_info),
       std::bind(LedgerClientMojoProxy::OnSaveActivityInfo, holder, _1, _2));
 }
 
@@ -570,13 +550,8 @@ void LedgerClientMojoProxy::OnGetActivityInfoList(
     CallbackHolder<GetActivityInfoListCallback>* holder,
     const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  std::vector<std::string> list;
-  for (const auto& publisher_info : publisher_info_list) {
-    list.push_back(publisher_info.ToJson());
-  }
-
   if (holder->is_valid())
-    std::move(holder->get()).Run(list, next_record);
+    std::move(holder->get()).Run(publisher_info_list, next_record);
   delete holder;
 }
 
@@ -601,10 +576,9 @@ void LedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
 }
 
 void LedgerClientMojoProxy::SaveNormalizedPublisherList(
-    const std::string& normalized_list) {
-
+    const ledger::PublisherInfoList& normalized_list) {
   ledger::PublisherInfoListStruct list;
-  list.loadFromJson(normalized_list);
+  list.list = normalized_list;
 
   ledger_client_->SaveNormalizedPublisherList(list);
 }
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 
@@ -47,7 +48,8 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
   void SavePublishersList(const std::string& publishers_list,
       SavePublishersListCallback callback) override;
 
-  void SavePublisherInfo(const std::string& publisher_info,
+  void SavePublisherInfo(
+      const base::Optional<ledger::PublisherInfo>& publisher_info,
       SavePublisherInfoCallback callback) override;
   void LoadPublisherInfo(const std::string& publisher_key,
       LoadPublisherInfoCallback callback) override;
@@ -66,7 +68,8 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
 
   void SetTimer(uint64_t time_offset, SetTimerCallback callback) override;
   void KillTimer(const uint32_t timer_id) override;
-  void OnPanelPublisherInfo(int32_t result, const std::string& info,
+  void OnPanelPublisherInfo(int32_t result,
+      const base::Optional<ledger::PublisherInfo>& info,
       uint64_t window_id) override;
   void OnExcludedSitesChanged(const std::string& publisher_id,
                               int exclude) override;
@@ -98,7 +101,8 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
   void LoadActivityInfo(const std::string& filter,
       LoadActivityInfoCallback callback) override;
 
-  void SaveActivityInfo(const std::string& publisher_info,
+  void SaveActivityInfo(
+      const base::Optional<ledger::PublisherInfo>& publisher_info,
       SaveActivityInfoCallback callback) override;
 
   void OnRestorePublishers(OnRestorePublishersCallback callback) override;
@@ -109,7 +113,7 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
                            GetActivityInfoListCallback callback) override;
 
   void SaveNormalizedPublisherList(
-    const std::string& normalized_list) override;
+    const ledger::PublisherInfoList& normalized_list) override;
   void SaveState(const std::string& name,
                               const std::string& value,
                               SaveStateCallback callback) override;